@@ -0,0 +1,137 @@
+/*
+ * CheckpointRegistry::Write/Read round trips and the refusal of corrupt files: a wrong magic,
+ * truncation, and record counts or lengths larger than the file could hold.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include "BlockCheckpoint.h"
+#include "TestSupport.h"
+
+using namespace BlockTypeSupports::BasicPythonSupport;
+using namespace BlockTypeSupports::BasicPythonSupport::Tests;
+
+namespace
+{
+
+const std::string path = "TestBlockCheckpoint.checkpoint";
+
+std::vector<unsigned char> Bytes(const std::string& file)
+{
+    std::ifstream in(file, std::ios::binary);
+    return std::vector<unsigned char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void Overwrite(const std::string& file, const std::vector<unsigned char>& bytes)
+{
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+void PatchUint(std::vector<unsigned char>& bytes, size_t offset, uint64_t value, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        bytes[offset + i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+std::vector<BlockCheckpointRecord> Records()
+{
+    std::vector<BlockCheckpointRecord> records(2);
+    records[0].blockId = "gain";
+    records[0].time = 1.5;
+    records[0].elementFormat = "d";
+    records[0].elementSize = sizeof(double);
+    records[0].inputCount = 1;
+    records[0].outputCount = 1;
+    records[0].inputs = {1, 2, 3, 4, 5, 6, 7, 8};
+    records[0].outputs = {8, 7, 6, 5, 4, 3, 2, 1};
+    records[0].memoTime = 1.25;
+    records[0].flags = 3;
+    records[0].pythonState = std::string("\x80\x04state", 7);
+    records[1].blockId = "empty"; // every byte string empty, the smallest record there is
+    return records;
+}
+
+void RoundTrip()
+{
+    std::vector<BlockCheckpointRecord> written = Records();
+    CheckpointRegistry::Write(path, written);
+    std::vector<BlockCheckpointRecord> read = CheckpointRegistry::Read(path);
+    TEST_CHECK(read.size() == written.size());
+    for (size_t i = 0; i < read.size() && i < written.size(); ++i)
+    {
+        TEST_CHECK(read[i].blockId == written[i].blockId);
+        TEST_CHECK(read[i].time == written[i].time);
+        TEST_CHECK(read[i].elementFormat == written[i].elementFormat);
+        TEST_CHECK(read[i].elementSize == written[i].elementSize);
+        TEST_CHECK(read[i].inputCount == written[i].inputCount);
+        TEST_CHECK(read[i].outputCount == written[i].outputCount);
+        TEST_CHECK(read[i].inputs == written[i].inputs);
+        TEST_CHECK(read[i].outputs == written[i].outputs);
+        TEST_CHECK(read[i].memoTime == written[i].memoTime);
+        TEST_CHECK(read[i].flags == written[i].flags);
+        TEST_CHECK(read[i].pythonState == written[i].pythonState);
+    }
+
+    CheckpointRegistry::Write(path, {});
+    TEST_CHECK(CheckpointRegistry::Read(path).empty());
+}
+
+void CorruptFiles()
+{
+    CheckpointRegistry::Write(path, Records());
+    const std::vector<unsigned char> valid = Bytes(path);
+    const size_t countOffset = 8 + sizeof(uint32_t); // after the magic and the version
+    const size_t firstLengthOffset = countOffset + sizeof(uint32_t);
+
+    std::vector<unsigned char> bytes = valid;
+    bytes[0] = 'X';
+    Overwrite(path, bytes);
+    TEST_CHECK(Throws([] { CheckpointRegistry::Read(path); }));
+
+    bytes = valid;
+    PatchUint(bytes, countOffset - sizeof(uint32_t), 99, sizeof(uint32_t));
+    Overwrite(path, bytes);
+    TEST_CHECK(Throws([] { CheckpointRegistry::Read(path); }));
+
+    // cut anywhere, including inside the header
+    for (size_t size : {size_t(4), countOffset + 2, valid.size() / 2, valid.size() - 1})
+    {
+        Overwrite(path, std::vector<unsigned char>(valid.begin(), valid.begin() + size));
+        TEST_CHECK(Throws([] { CheckpointRegistry::Read(path); }));
+    }
+
+    // counts and lengths no file this size could hold are refused before anything is allocated
+    bytes = valid;
+    PatchUint(bytes, countOffset, 0xFFFFFFFFu, sizeof(uint32_t));
+    Overwrite(path, bytes);
+    TEST_CHECK(Throws([] { CheckpointRegistry::Read(path); }));
+
+    bytes = valid;
+    PatchUint(bytes, countOffset, 3, sizeof(uint32_t));
+    Overwrite(path, bytes);
+    TEST_CHECK(Throws([] { CheckpointRegistry::Read(path); }));
+
+    bytes = valid;
+    PatchUint(bytes, firstLengthOffset, UINT64_MAX / 2, sizeof(uint64_t));
+    Overwrite(path, bytes);
+    TEST_CHECK(Throws([] { CheckpointRegistry::Read(path); }));
+
+    TEST_CHECK(Throws([] { CheckpointRegistry::Read("TestBlockCheckpoint.missing"); }));
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+int main()
+{
+    RoundTrip();
+    CorruptFiles();
+    return Result("TestBlockCheckpoint");
+}
@@ -0,0 +1,127 @@
+/*
+ * BlockTraceWriter/BlockTraceReader round trips, resync after a diverging call and layout checks,
+ * then record and replay through a block, including the TraceMismatch choices.
+ */
+
+#include <cstdio>
+#include <stdexcept>
+
+#include "BlockTrace.h"
+#include "TestSupport.h"
+
+using namespace BlockTypeSupports::BasicPythonSupport;
+using namespace BlockTypeSupports::BasicPythonSupport::Tests;
+
+namespace
+{
+
+void ReaderAndWriter()
+{
+    const std::string path = "TestBlockTrace.readwrite.trace";
+    TraceLayout layout{"d", sizeof(double), 2, 1};
+    const int records = 5000; // grows the mapping several times
+
+    {
+        BlockTraceWriter writer(path, layout);
+        for (int k = 0; k < records; ++k)
+        {
+            double inputs[2] = {double(k), -double(k)};
+            double output = 3.0 * k;
+            writer.Append(0.1 * k, inputs, &output);
+        }
+        TEST_CHECK(writer.GetRecordCount() == records);
+    }
+
+    {
+        BlockTraceReader reader(path, layout);
+        TEST_CHECK(reader.GetRecordCount() == records);
+        for (int k = 0; k < 10; ++k)
+        {
+            double inputs[2] = {double(k), -double(k)};
+            double output = 0.0;
+            TEST_CHECK(reader.Next(0.1 * k, inputs, &output));
+            TEST_CHECK(output == 3.0 * k);
+        }
+
+        // a call the recording never made misses, the reader then picks up a few records later
+        double diverged[2] = {0.5, 0.5};
+        double output = 0.0;
+        TEST_CHECK(!reader.Next(1.0, diverged, &output));
+        double inputs[2] = {13.0, -13.0};
+        TEST_CHECK(reader.Next(0.1 * 13, inputs, &output));
+        TEST_CHECK(output == 39.0);
+        TEST_CHECK(reader.GetHitCount() == 11);
+        TEST_CHECK(reader.GetMissCount() == 1);
+    }
+
+    // another port layout or element type is refused
+    TEST_CHECK(Throws([&] { BlockTraceReader reader(path, TraceLayout{"d", sizeof(double), 1, 1}); }));
+    TEST_CHECK(Throws([&] { BlockTraceReader reader(path, TraceLayout{"Zd", 2 * sizeof(double), 2, 1}); }));
+    std::remove(path.c_str());
+
+    // and so is a file that is not a trace
+    const std::string other = "TestBlockTrace.other.trace";
+    std::FILE* file = std::fopen(other.c_str(), "wb");
+    std::fputs("not a trace, but long enough to hold a header of sixty-four bytes.......", file);
+    std::fclose(file);
+    TEST_CHECK(Throws([&] { BlockTraceReader reader(other, layout); }));
+    std::remove(other.c_str());
+}
+
+void RecordAndReplay(BlockFactoryPython& factory)
+{
+    const std::string path = "TestBlockTrace.block.trace";
+    auto traced = [&](double gain, const std::string& mode, const std::string& mismatch) {
+        std::map<std::string, PySysLinkBase::ConfigurationValue> configuration = {
+            {"Gain", gain}, {"TraceMode", mode}, {"TracePath", path}};
+        if (!mismatch.empty()) configuration["TraceMismatch"] = mismatch;
+        return MakeBlock(factory, "Gain", configuration);
+    };
+
+    {
+        auto recorder = traced(2.0, "Record", "");
+        for (int k = 0; k < 20; ++k)
+        {
+            SetInput(recorder, 0, k);
+            recorder->_ComputeOutputsOfBlock(recorder->GetSampleTime(), k);
+        }
+    }
+
+    // the replaying block has another gain, so its outputs show where they came from
+    for (const std::string mismatch : {"", "Error", "Compute"})
+    {
+        auto replayer = traced(5.0, "Replay", mismatch);
+        auto sampleTime = replayer->GetSampleTime();
+        for (int k = 0; k < 20; ++k)
+        {
+            SetInput(replayer, 0, k);
+            replayer->_ComputeOutputsOfBlock(sampleTime, k);
+            TEST_CHECK(GetOutput(replayer, 0) == 2.0 * k);
+        }
+
+        // Gain does not declare pure, so an empty TraceMismatch means "Error"
+        SetInput(replayer, 0, 100.0);
+        if (mismatch == "Compute")
+        {
+            replayer->_ComputeOutputsOfBlock(sampleTime, 20.0);
+            TEST_CHECK(GetOutput(replayer, 0) == 500.0);
+        }
+        else
+        {
+            TEST_CHECK(Throws([&] { replayer->_ComputeOutputsOfBlock(sampleTime, 20.0); }));
+        }
+    }
+    std::remove(path.c_str());
+
+    TEST_CHECK(Throws([&] { traced(5.0, "Replay", "Sometimes"); }));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    ReaderAndWriter();
+    auto factory = MakeFactory(argv[1]);
+    RecordAndReplay(*factory);
+    return Result("TestBlockTrace");
+}
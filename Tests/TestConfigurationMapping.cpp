@@ -0,0 +1,117 @@
+/*
+ * The read-only configuration mapping python blocks receive with lazyConfiguration: dict-like reads,
+ * zero-copy array values with the buffer protocol, refused writes, and one shared mapping per
+ * identical configuration.
+ */
+
+#include <complex>
+
+#include "ConfigurationMapping.h"
+#include "TestSupport.h"
+
+using namespace BlockTypeSupports::BasicPythonSupport;
+using namespace BlockTypeSupports::BasicPythonSupport::Tests;
+
+namespace
+{
+
+// Runs python statements with the given names bound, false (after printing it) if anything raised
+bool RunPython(const char* code, const std::map<std::string, PyObject*>& names)
+{
+    PyObject* globals = PyDict_New();
+    PyDict_SetItemString(globals, "__builtins__", PyEval_GetBuiltins());
+    for (const auto& [name, value] : names) PyDict_SetItemString(globals, name.c_str(), value);
+    PyObject* result = PyRun_String(code, Py_file_input, globals, globals);
+    Py_DECREF(globals);
+    if (!result)
+    {
+        PyErr_Print();
+        return false;
+    }
+    Py_DECREF(result);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // starts the interpreter
+    auto factory = MakeFactory(argv[1]);
+    auto executor = MainInterpreterExecutor::Instance();
+
+    std::map<std::string, PySysLinkBase::ConfigurationValue> configuration = {
+        {"Gain", 2.5},
+        {"Count", 3},
+        {"Enabled", true},
+        {"Label", std::string("a \"quoted\" label")},
+        {"Pole", std::complex<double>(-1.0, 2.0)},
+        {"Table", std::vector<double>{1.0, 2.0, 4.0, 8.0}},
+        {"Taps", std::vector<int>{3, 1, 4}},
+    };
+    auto other = configuration;
+    other["Gain"] = 3.5;
+
+    {
+        ConfigurationMappingCache cache;
+        executor->Execute([&] {
+            PyObject* mapping = cache.GetMapping(executor, configuration);
+            PyObject* same = cache.GetMapping(executor, configuration);
+            PyObject* different = cache.GetMapping(executor, other);
+            TEST_CHECK(mapping && same && different);
+            if (!mapping || !same || !different) return;
+
+            TEST_CHECK(mapping == same);
+            TEST_CHECK(mapping != different);
+            TEST_CHECK(RunPython(R"(
+assert len(m) == 7
+assert m["Gain"] == 2.5 and m["Count"] == 3 and m["Enabled"] is True
+assert m["Label"] == 'a "quoted" label'
+assert m["Pole"] == complex(-1.0, 2.0)
+assert "Gain" in m and "Missing" not in m
+assert m.get("Missing") is None and m.get("Missing", 7) == 7
+assert sorted(m.keys()) == sorted(["Gain", "Count", "Enabled", "Label", "Pole", "Table", "Taps"])
+assert dict(m.items())["Count"] == 3
+assert other["Gain"] == 3.5 and other["Table"][3] == 8.0
+
+table = m["Table"]
+assert table is m["Table"]
+assert len(table) == 4 and table[1] == 2.0 and table[-1] == 8.0
+assert list(table) == [1.0, 2.0, 4.0, 8.0] and table.tolist() == [1.0, 2.0, 4.0, 8.0]
+assert list(table[::2]) == [1.0, 4.0]
+view = memoryview(table)
+assert view.format == "d" and view.readonly and view.nbytes == 32 and view.tolist() == [1.0, 2.0, 4.0, 8.0]
+view.release()
+assert list(m["Taps"]) == [3, 1, 4]
+
+def assign_gain():
+    m["Gain"] = 1.0
+
+def assign_table():
+    table[0] = 0.0
+
+for write in (assign_gain, assign_table):
+    try:
+        write()
+    except TypeError:
+        pass
+    else:
+        raise AssertionError("write was accepted")
+
+copy = m.copy()
+copy["Gain"] = 1.0
+assert m["Gain"] == 2.5
+)", {{"m", mapping}, {"other", different}}));
+
+            Py_DECREF(mapping);
+            Py_DECREF(same);
+            Py_DECREF(different);
+        });
+    }
+
+    TEST_CHECK(IsBridgeConfigurationKey("PythonClass"));
+    TEST_CHECK(IsBridgeConfigurationKey("SurrogateRanges"));
+    TEST_CHECK(!IsBridgeConfigurationKey("Gain"));
+
+    return Result("TestConfigurationMapping");
+}
@@ -0,0 +1,38 @@
+/*
+ * A block with continuous states is never memoized or replaced by a surrogate, even if it declares
+ * pure: its outputs change with the states the solver sets, not with its inputs.
+ */
+
+#include <PySysLinkBase/ISimulationBlockWithContinuousStates.h>
+
+#include "TestSupport.h"
+
+using namespace BlockTypeSupports::BasicPythonSupport;
+using namespace BlockTypeSupports::BasicPythonSupport::Tests;
+
+int main(int argc, char** argv)
+{
+    auto factory = MakeFactory(argv[1]);
+    auto block = MakeBlock(*factory, "PureIntegrator", {{"Surrogate", std::string("Table")},
+                                                        {"SurrogateRanges", std::vector<double>{-1.0, 1.0}}});
+    auto continuous = std::dynamic_pointer_cast<SimulationBlockPythonContinuous<double>>(block);
+    TEST_CHECK(continuous != nullptr);
+    if (!continuous) return Result("TestContinuousBlock");
+
+    TEST_CHECK(continuous->GetPurity() == SimulationBlockPythonContinuous<double>::Purity::None);
+    auto sampleTime = block->GetSampleTime();
+
+    // same input and time every call, only the states differ
+    SetInput(block, 0, 0.5);
+    for (double x : {1.0, 2.0, 3.0})
+    {
+        continuous->SetContinuousStates({x});
+        block->_ComputeOutputsOfBlock(sampleTime, 0.0);
+        TEST_CHECK(GetOutput(block, 0) == x);
+        TEST_CHECK(continuous->GetContinuousStateDerivatives(sampleTime, 0.0) == std::vector<double>{0.5});
+    }
+    TEST_CHECK(continuous->GetSurrogateHitCount() == 0);
+    TEST_CHECK(continuous->GetMemoHitCount() == 0);
+
+    return Result("TestContinuousBlock");
+}
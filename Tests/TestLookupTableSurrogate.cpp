@@ -0,0 +1,147 @@
+/*
+ * LookupTableSurrogate reproduces multilinear functions exactly, refuses out-of-range and NaN inputs
+ * and rejects malformed grids; a block declaring pure = "inputs" is answered from the table only
+ * when the table meets SurrogateTolerance, also after a configuration update resampled it.
+ */
+
+#include <cmath>
+#include <limits>
+
+#include "LookupTableSurrogate.h"
+#include "TestSupport.h"
+
+using namespace BlockTypeSupports::BasicPythonSupport;
+using namespace BlockTypeSupports::BasicPythonSupport::Tests;
+
+namespace
+{
+
+void Table()
+{
+    // both outputs are multilinear in (x, y), so interpolation is exact between grid points
+    auto bilinear = [](const double* in, double* out) {
+        out[0] = 2.0 * in[0] + 3.0 * in[1];
+        out[1] = in[0] * in[1];
+    };
+    LookupTableSurrogate table(2, 2, {0.0, 1.0, -1.0, 1.0}, {5, 9});
+    table.Build(bilinear);
+    TEST_CHECK(table.GetSampleCount() == 45);
+    TEST_CHECK(table.MaxError(bilinear, 200) < 1e-12);
+
+    double in[2] = {0.3, -0.7};
+    double out[2] = {0.0, 0.0};
+    TEST_CHECK(table.Evaluate(in, out));
+    TEST_CHECK(std::abs(out[0] - (0.6 - 2.1)) < 1e-12);
+    TEST_CHECK(std::abs(out[1] - (-0.21)) < 1e-12);
+
+    // the range ends are inside, anything past them or NaN is left to compute()
+    double corner[2] = {1.0, -1.0};
+    TEST_CHECK(table.Evaluate(corner, out));
+    for (double x : {-0.01, 1.01, std::numeric_limits<double>::quiet_NaN()})
+    {
+        double outside[2] = {x, 0.0};
+        TEST_CHECK(!table.Evaluate(outside, out));
+    }
+
+    // a curved function is only approximated, more points approximate it better
+    auto curved = [](const double* in, double* out) { out[0] = std::sin(3.0 * in[0]); };
+    LookupTableSurrogate coarse(1, 1, {0.0, 2.0}, {5});
+    LookupTableSurrogate fine(1, 1, {0.0, 2.0}, {500});
+    coarse.Build(curved);
+    fine.Build(curved);
+    double coarseError = coarse.MaxError(curved, 200);
+    double fineError = fine.MaxError(curved, 200);
+    TEST_CHECK(coarseError > 1e-3);
+    TEST_CHECK(fineError < 1e-4);
+
+    TEST_CHECK(Throws([] { LookupTableSurrogate(0, 1, {}, {65}); }));
+    TEST_CHECK(Throws([] { LookupTableSurrogate(5, 1, std::vector<double>(10, 1.0), {3}); }));
+    TEST_CHECK(Throws([] { LookupTableSurrogate(2, 1, {0.0, 1.0}, {65}); }));
+    TEST_CHECK(Throws([] { LookupTableSurrogate(1, 1, {1.0, 1.0}, {65}); }));
+    TEST_CHECK(Throws([] { LookupTableSurrogate(1, 1, {0.0, 1.0}, {1}); }));
+    TEST_CHECK(Throws([] { LookupTableSurrogate(2, 1, {0.0, 1.0, 0.0, 1.0}, {2000}); }));
+}
+
+std::shared_ptr<SimulationBlockPython<double>> SurrogateBlock(BlockFactoryPython& factory, int points, double tolerance,
+                                                              const std::string& pythonClass = "PureSquare")
+{
+    auto block = MakeBlock(factory, pythonClass, {{"Surrogate", std::string("Table")},
+                                                   {"SurrogateRanges", std::vector<double>{-2.0, 2.0}},
+                                                   {"SurrogatePoints", std::vector<int>{points}},
+                                                   {"SurrogateCheckPoints", 100},
+                                                   {"SurrogateTolerance", tolerance}});
+    return std::dynamic_pointer_cast<SimulationBlockPython<double>>(block);
+}
+
+void Block(BlockFactoryPython& factory)
+{
+    auto block = SurrogateBlock(factory, 401, 1e-3);
+    TEST_CHECK(block != nullptr);
+    if (!block) return;
+    auto sampleTime = block->GetSampleTime();
+
+    // distinct inputs, so the memo never answers
+    for (int k = 0; k < 10; ++k)
+    {
+        double x = -1.9 + 0.37 * k;
+        SetInput(block, 0, x);
+        block->_ComputeOutputsOfBlock(sampleTime, k);
+        TEST_CHECK(std::abs(GetOutput(block, 0) - x * x) < 1e-3);
+    }
+    TEST_CHECK(block->GetSurrogateHitCount() == 10);
+
+    // out of range: compute() answers, exactly
+    SetInput(block, 0, 3.0);
+    block->_ComputeOutputsOfBlock(sampleTime, 10.0);
+    TEST_CHECK(GetOutput(block, 0) == 9.0);
+    TEST_CHECK(block->GetSurrogateMissCount() == 1);
+
+    // a table that misses the tolerance is dropped, compute() answers every call
+    auto rough = SurrogateBlock(factory, 3, 1e-6);
+    TEST_CHECK(rough != nullptr);
+    if (!rough) return;
+    SetInput(rough, 0, 0.5);
+    rough->_ComputeOutputsOfBlock(sampleTime, 0.0);
+    TEST_CHECK(GetOutput(rough, 0) == 0.25);
+    TEST_CHECK(rough->GetSurrogateHitCount() == 0);
+    TEST_CHECK(rough->GetSurrogateMissCount() == 0);
+}
+
+void Update(BlockFactoryPython& factory)
+{
+    // 401 points over [-2, 2] interpolate Gain * x^2 within Gain * 2.5e-5
+    auto block = SurrogateBlock(factory, 401, 1e-3, "PureScaledSquare");
+    TEST_CHECK(block != nullptr);
+    if (!block) return;
+    auto sampleTime = block->GetSampleTime();
+
+    // still within the tolerance: the resampled table answers with the new gain
+    TEST_CHECK(block->_TryUpdateConfigurationValue("Gain", 10.0));
+    SetInput(block, 0, 0.5);
+    block->_ComputeOutputsOfBlock(sampleTime, 0.0);
+    TEST_CHECK(std::abs(GetOutput(block, 0) - 2.5) < 1e-3);
+    TEST_CHECK(block->GetSurrogateHitCount() == 1);
+
+    // off by 2.5e-3 now: the table is dropped and compute() answers exactly
+    TEST_CHECK(block->_TryUpdateConfigurationValue("Gain", 100.0));
+    SetInput(block, 0, 0.25);
+    block->_ComputeOutputsOfBlock(sampleTime, 1.0);
+    TEST_CHECK(GetOutput(block, 0) == 6.25);
+    TEST_CHECK(block->GetSurrogateHitCount() == 1);
+    TEST_CHECK(block->GetSurrogateMissCount() == 0);
+    TEST_CHECK(block->GetConfigurationUpdateCount() == 2);
+
+    TEST_CHECK(!block->_TryUpdateConfigurationValue("Offset", 1.0));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Table();
+    // plain SimulationBlockPython<double> blocks even in builds with fixed-port specializations
+    auto factory = MakeFactory(argv[1], {{"BasicPythonSupport/fixedPortSpecializations", false}});
+    Block(*factory);
+    Update(*factory);
+    return Result("TestLookupTableSurrogate");
+}
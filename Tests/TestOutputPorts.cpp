@@ -0,0 +1,46 @@
+/*
+ * Outputs reach the engine through OutputPort::SetValue, so they read back through any later
+ * GetValue() call whether or not the port hands out copies of the value it holds.
+ */
+
+#include "TestSupport.h"
+
+using namespace BlockTypeSupports::BasicPythonSupport;
+using namespace BlockTypeSupports::BasicPythonSupport::Tests;
+
+int main(int argc, char** argv)
+{
+    auto factory = MakeFactory(argv[1]);
+    auto block = MakeBlock(*factory, "Gain", {{"Gain", 3.0}, {"InputPortNumber", 2}, {"OutputPortNumber", 2}});
+    auto sampleTime = block->GetSampleTime();
+
+    SetInput(block, 0, 1.0);
+    SetInput(block, 1, -2.0);
+    block->_ComputeOutputsOfBlock(sampleTime, 0.0);
+    TEST_CHECK(GetOutput(block, 0) == 3.0);
+    TEST_CHECK(GetOutput(block, 1) == -6.0);
+    // a second read sees the same values
+    TEST_CHECK(GetOutput(block, 0) == 3.0);
+    TEST_CHECK(GetOutput(block, 1) == -6.0);
+
+    SetInput(block, 0, 4.0);
+    block->_ComputeOutputsOfBlock(sampleTime, 1.0);
+    TEST_CHECK(GetOutput(block, 0) == 12.0);
+    TEST_CHECK(GetOutput(block, 1) == -6.0);
+
+    // vector signals publish a fresh payload every step too
+    auto arrayBlock = MakeBlock(*factory, "VectorGain", {{"Gain", 2.0}, {"SignalType", std::string("DoubleVector")}, {"SignalShape", std::vector<int>{3}}});
+    std::vector<double> in = {1.0, 2.0, 3.0};
+    arrayBlock->GetInputPorts()[0]->SetValue(std::make_shared<PySysLinkBase::SignalValue<std::vector<double>>>(in));
+    arrayBlock->_ComputeOutputsOfBlock(sampleTime, 0.0);
+    auto out = arrayBlock->GetOutputPorts()[0]->GetValue()->TryCastToTyped<std::vector<double>>()->GetPayload();
+    TEST_CHECK((out == std::vector<double>{2.0, 4.0, 6.0}));
+
+    in = {0.5, 0.5, 0.5};
+    arrayBlock->GetInputPorts()[0]->SetValue(std::make_shared<PySysLinkBase::SignalValue<std::vector<double>>>(in));
+    arrayBlock->_ComputeOutputsOfBlock(sampleTime, 1.0);
+    out = arrayBlock->GetOutputPorts()[0]->GetValue()->TryCastToTyped<std::vector<double>>()->GetPayload();
+    TEST_CHECK((out == std::vector<double>{1.0, 1.0, 1.0}));
+
+    return Result("TestOutputPorts");
+}
@@ -0,0 +1,130 @@
+/*
+ * Steady-state list exchange steps of a float block box nothing: the input floats and the time
+ * are refilled in place. Measured with a counting allocator wrapped around the interpreter's
+ * object and mem domains, the ones sys.getallocatedblocks() and tracemalloc observe. CPython's
+ * float free list hides boxing from those counts, so python also checks it is handed the same objects.
+ * Floats python keeps a reference to are replaced instead, so kept values do not change.
+ */
+
+#include <atomic>
+
+#include "TestSupport.h"
+
+using namespace BlockTypeSupports::BasicPythonSupport;
+using namespace BlockTypeSupports::BasicPythonSupport::Tests;
+
+namespace
+{
+
+std::atomic<unsigned long long> pythonAllocations{0};
+PyMemAllocatorEx wrappedObject;
+PyMemAllocatorEx wrappedMem;
+
+void* CountingMalloc(void* ctx, size_t size)
+{
+    ++pythonAllocations;
+    auto* wrapped = static_cast<PyMemAllocatorEx*>(ctx);
+    return wrapped->malloc(wrapped->ctx, size);
+}
+
+void* CountingCalloc(void* ctx, size_t count, size_t size)
+{
+    ++pythonAllocations;
+    auto* wrapped = static_cast<PyMemAllocatorEx*>(ctx);
+    return wrapped->calloc(wrapped->ctx, count, size);
+}
+
+void* CountingRealloc(void* ctx, void* ptr, size_t size)
+{
+    ++pythonAllocations;
+    auto* wrapped = static_cast<PyMemAllocatorEx*>(ctx);
+    return wrapped->realloc(wrapped->ctx, ptr, size);
+}
+
+void ForwardFree(void* ctx, void* ptr)
+{
+    auto* wrapped = static_cast<PyMemAllocatorEx*>(ctx);
+    wrapped->free(wrapped->ctx, ptr);
+}
+
+// Same hook point as tracemalloc, wraps the running allocators. Caller holds the GIL.
+void InstallCountingAllocator()
+{
+    PyMem_GetAllocator(PYMEM_DOMAIN_OBJ, &wrappedObject);
+    PyMem_GetAllocator(PYMEM_DOMAIN_MEM, &wrappedMem);
+    PyMemAllocatorEx counting = {&wrappedObject, CountingMalloc, CountingCalloc, CountingRealloc, ForwardFree};
+    PyMem_SetAllocator(PYMEM_DOMAIN_OBJ, &counting);
+    counting.ctx = &wrappedMem;
+    PyMem_SetAllocator(PYMEM_DOMAIN_MEM, &counting);
+}
+
+void RemoveCountingAllocator()
+{
+    PyMem_SetAllocator(PYMEM_DOMAIN_OBJ, &wrappedObject);
+    PyMem_SetAllocator(PYMEM_DOMAIN_MEM, &wrappedMem);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // more ports than the fixed-port specializations cover, so the block is a SimulationBlockPython<double>
+    const int inputs = 12;
+    const int steps = 1000;
+
+    auto factory = MakeFactory(argv[1]);
+    auto block = MakeBlock(*factory, "Passthrough", {{"InputPortNumber", inputs}, {"OutputPortNumber", inputs}});
+    auto pythonBlock = std::dynamic_pointer_cast<SimulationBlockPython<double>>(block);
+    auto sampleTime = block->GetSampleTime();
+
+    for (int step = 0; step < 10; ++step)
+    {
+        for (int i = 0; i < inputs; ++i) SetInput(block, i, step + i);
+        block->_ComputeOutputsOfBlock(sampleTime, step);
+    }
+
+    unsigned long long bridgeCount = pythonBlock->GetObjectAllocationCount();
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    InstallCountingAllocator();
+    PyGILState_Release(gstate);
+    for (int step = 0; step < steps; ++step)
+    {
+        for (int i = 0; i < inputs; ++i) SetInput(block, i, 0.5 * step + i);
+        block->_ComputeOutputsOfBlock(sampleTime, 1e-3 * step);
+        if (step == steps - 1)
+        {
+            for (int i = 0; i < inputs; ++i) TEST_CHECK(GetOutput(block, i) == 0.5 * step + i);
+        }
+    }
+    gstate = PyGILState_Ensure();
+    RemoveCountingAllocator();
+    PyGILState_Release(gstate);
+
+    std::cerr << "python allocations over " << steps << " steps of " << inputs << " float inputs: " << pythonAllocations << std::endl;
+    TEST_CHECK(pythonAllocations < steps / 10);
+    TEST_CHECK(pythonBlock->GetObjectAllocationCount() == bridgeCount);
+
+    auto distinct = MakeBlock(*factory, "CountDistinctArguments", {{"OutputPortNumber", 2}});
+    for (int step = 0; step < 100; ++step)
+    {
+        SetInput(distinct, 0, step);
+        distinct->_ComputeOutputsOfBlock(sampleTime, step);
+    }
+    TEST_CHECK(GetOutput(distinct, 0) == 1.0);
+    TEST_CHECK(GetOutput(distinct, 1) == 1.0);
+
+    // references kept by python are never refilled
+    auto keeping = MakeBlock(*factory, "KeepFirstInput", {{"OutputPortNumber", 3}});
+    SetInput(keeping, 0, 1.25);
+    keeping->_ComputeOutputsOfBlock(sampleTime, 0.5);
+    for (int step = 1; step < 5; ++step)
+    {
+        SetInput(keeping, 0, 10.0 * step);
+        keeping->_ComputeOutputsOfBlock(sampleTime, 0.5 + step);
+        TEST_CHECK(GetOutput(keeping, 0) == 10.0 * step);
+        TEST_CHECK(GetOutput(keeping, 1) == 1.25);
+        TEST_CHECK(GetOutput(keeping, 2) == 0.5);
+    }
+
+    return Result("TestPythonAllocations");
+}
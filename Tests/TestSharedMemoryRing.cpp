@@ -0,0 +1,112 @@
+/*
+ * SharedMemoryRing round trips across the end of the ring, refuses writes that do not fit without
+ * touching its state, and the same holds end to end through a worker process on a small ring.
+ * Worker processes inherit no descriptors but their own.
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#include "ProcessWorkerPool.h"
+#include "TestSupport.h"
+
+using namespace BlockTypeSupports::BasicPythonSupport;
+using namespace BlockTypeSupports::BasicPythonSupport::Tests;
+
+namespace
+{
+
+void RingRoundTrips()
+{
+    const uint64_t capacity = 64;
+    std::vector<char> memory(sizeof(SharedMemoryRingHeader) + capacity);
+    SharedMemoryRing ring(memory.data(), capacity);
+    TEST_CHECK(ring.Available() == 0);
+    TEST_CHECK(ring.Free() == capacity);
+
+    // 24 does not divide 64, so messages start at every offset and split across the end
+    char message[24];
+    char received[24];
+    for (int round = 0; round < 50; ++round)
+    {
+        for (size_t k = 0; k < sizeof(message); ++k) message[k] = static_cast<char>(round * 31 + k);
+        ring.Write(message, sizeof(message));
+        TEST_CHECK(ring.Available() == sizeof(message));
+        TEST_CHECK(ring.Free() == capacity - sizeof(message));
+        ring.Read(received, sizeof(received));
+        TEST_CHECK(std::memcmp(message, received, sizeof(message)) == 0);
+        TEST_CHECK(ring.Available() == 0);
+    }
+
+    // a write larger than the free space is refused and leaves the ring as it was
+    ring.Write(message, sizeof(message));
+    ring.Write(message, sizeof(message));
+    TEST_CHECK(Throws([&] { ring.Write(message, sizeof(message)); }));
+    TEST_CHECK(ring.Available() == 2 * sizeof(message));
+    ring.Read(received, sizeof(received));
+    ring.Read(received, sizeof(received));
+    TEST_CHECK(std::memcmp(message, received, sizeof(message)) == 0);
+
+    // so is a read of more than was written
+    TEST_CHECK(Throws([&] { ring.Read(received, 1); }));
+    TEST_CHECK(ring.Free() == capacity);
+}
+
+void WorkerRoundTrips(const std::string& testDirectory)
+{
+    auto factory = MakeFactory(testDirectory, {
+        {"BasicPythonSupport/processRingBytes", 1024},
+        {"BasicPythonSupport/processWorkerScript", testDirectory + "/../src/pysyslink_python_worker.py"},
+    });
+
+    // each compute is a 40 byte request and reply, which wraps the 1024 byte rings every few dozen steps
+    auto block = MakeBlock(*factory, "Gain", {{"ExecutionBackend", std::string("Process")}, {"Gain", 3.0},
+                                              {"InputPortNumber", 2}, {"OutputPortNumber", 2}});
+    auto sampleTime = block->GetSampleTime();
+    for (int step = 0; step < 200; ++step)
+    {
+        SetInput(block, 0, step);
+        SetInput(block, 1, -step);
+        block->_ComputeOutputsOfBlock(sampleTime, step);
+        TEST_CHECK(GetOutput(block, 0) == 3.0 * step);
+        TEST_CHECK(GetOutput(block, 1) == -3.0 * step);
+    }
+
+    // 200 inputs do not fit the request ring, the call fails before anything is written
+    auto wide = MakeBlock(*factory, "Gain", {{"ExecutionBackend", std::string("Process")},
+                                             {"InputPortNumber", 200}, {"OutputPortNumber", 200}});
+    TEST_CHECK(Throws([&] { wide->_ComputeOutputsOfBlock(sampleTime, 0.0); }));
+
+    // and the worker still reads well formed messages afterwards
+    SetInput(block, 0, 7.0);
+    block->_ComputeOutputsOfBlock(sampleTime, 200.0);
+    TEST_CHECK(GetOutput(block, 0) == 21.0);
+}
+
+// Workers are started one after another, each must only hold its own ring and eventfds
+void WorkersInheritOnlyTheirOwnDescriptors(const std::string& testDirectory)
+{
+    auto factory = MakeFactory(testDirectory, {
+        {"BasicPythonSupport/processWorkerCount", 3},
+        {"BasicPythonSupport/processWorkerScript", testDirectory + "/../src/pysyslink_python_worker.py"},
+    });
+    std::vector<double> counts;
+    for (int worker = 0; worker < 3; ++worker)
+    {
+        auto block = MakeBlock(*factory, "OpenDescriptors", {{"ExecutionBackend", std::string("Process")}});
+        block->_ComputeOutputsOfBlock(block->GetSampleTime(), 0.0);
+        counts.push_back(GetOutput(block, 0));
+    }
+    TEST_CHECK(counts[0] == counts[1]);
+    TEST_CHECK(counts[1] == counts[2]);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    RingRoundTrips();
+    WorkerRoundTrips(argv[1]);
+    WorkersInheritOnlyTheirOwnDescriptors(argv[1]);
+    return Result("TestSharedMemoryRing");
+}
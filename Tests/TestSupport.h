@@ -0,0 +1,89 @@
+#ifndef TESTS_TEST_SUPPORT_H
+#define TESTS_TEST_SUPPORT_H
+
+#pragma once
+
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <PySysLinkBase/ConfigurationValue.h>
+#include <PySysLinkBase/IBlockEventsHandler.h>
+#include <PySysLinkBase/ISimulationBlock.h>
+#include <PySysLinkBase/PortsAndSignalValues/SignalValue.h>
+
+#include "BlockFactoryPython.h"
+
+namespace BlockTypeSupports::BasicPythonSupport::Tests
+{
+
+inline int failures = 0;
+
+// Records a failure and keeps going, main() returns the failure count
+#define TEST_CHECK(condition)                                                                        \
+    do {                                                                                             \
+        if (!(condition)) {                                                                          \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl;  \
+            ++::BlockTypeSupports::BasicPythonSupport::Tests::failures;                              \
+        }                                                                                            \
+    } while (false)
+
+// True if call throws any std::exception
+inline bool Throws(const std::function<void()>& call)
+{
+    try {
+        call();
+    } catch (std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+// The blocks under test raise no events, nothing needs to receive them
+class NullBlockEventsHandler : public PySysLinkBase::IBlockEventsHandler
+{
+public:
+    void BlockEventCallback(const std::shared_ptr<PySysLinkBase::BlockEvent> blockEvent) const override {}
+    void RegisterBlockEventCallbacks(const std::function<void (std::shared_ptr<PySysLinkBase::BlockEvent>)> blockEventCallback) override {}
+};
+
+// Factory importing from the directory holding test_blocks.py, passed as argv[1] by ctest
+inline std::unique_ptr<BlockFactoryPython> MakeFactory(const std::string& moduleDirectory,
+                                                       std::map<std::string, PySysLinkBase::ConfigurationValue> pluginConfiguration = {})
+{
+    pluginConfiguration["BasicPythonSupport/pythonModulePaths"] = std::vector<std::string>{moduleDirectory};
+    return std::make_unique<BlockFactoryPython>(pluginConfiguration);
+}
+
+inline std::shared_ptr<PySysLinkBase::ISimulationBlock> MakeBlock(BlockFactoryPython& factory, const std::string& pythonClass,
+                                                                  std::map<std::string, PySysLinkBase::ConfigurationValue> blockConfiguration = {})
+{
+    blockConfiguration["PythonModule"] = std::string("test_blocks");
+    blockConfiguration["PythonClass"] = pythonClass;
+    return factory.CreateBlock(blockConfiguration, std::make_shared<NullBlockEventsHandler>());
+}
+
+inline void SetInput(const std::shared_ptr<PySysLinkBase::ISimulationBlock>& block, size_t port, double value)
+{
+    block->GetInputPorts()[port]->SetValue(std::make_shared<PySysLinkBase::SignalValue<double>>(value));
+}
+
+inline double GetOutput(const std::shared_ptr<PySysLinkBase::ISimulationBlock>& block, size_t port)
+{
+    return block->GetOutputPorts()[port]->GetValue()->TryCastToTyped<double>()->GetPayload();
+}
+
+inline int Result(const char* name)
+{
+    if (failures == 0) std::cerr << name << ": passed" << std::endl;
+    else std::cerr << name << ": " << failures << " check(s) failed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
+
+} // namespace BlockTypeSupports::BasicPythonSupport::Tests
+
+#endif // TESTS_TEST_SUPPORT_H
@@ -0,0 +1,126 @@
+"""Python blocks instantiated by the unit tests."""
+
+
+class Gain:
+    """outputs = Gain * inputs, Gain from the block configuration."""
+
+    def __init__(self, config):
+        self.gain = config.get("Gain", 2.0)
+
+    def compute(self, inputs, t):
+        return [self.gain * x for x in inputs]
+
+    def update_configuration(self, key, value):
+        if key != "Gain":
+            return False
+        self.gain = value
+        return True
+
+
+class VectorGain:
+    """Vector signals: every element of every port times Gain."""
+
+    def __init__(self, config):
+        self.gain = config.get("Gain", 2.0)
+
+    def compute(self, inputs, t):
+        return [[self.gain * v for v in x.tolist()] for x in inputs]
+
+
+class Passthrough:
+    """outputs = inputs, the inputs list itself is returned."""
+
+    def __init__(self, config):
+        pass
+
+    def compute(self, inputs, t):
+        return inputs
+
+
+class KeepFirstInput:
+    """Holds on to the first input and time it was handed, outputs [input, kept input, kept time]."""
+
+    def __init__(self, config):
+        self.kept_input = None
+        self.kept_time = None
+
+    def compute(self, inputs, t):
+        if self.kept_input is None:
+            self.kept_input = inputs[0]
+            self.kept_time = t
+        return [inputs[0], self.kept_input, self.kept_time]
+
+
+class CountDistinctArguments:
+    """Outputs how many distinct first-input and time objects it has been handed so far."""
+
+    def __init__(self, config):
+        self.input_ids = set()
+        self.time_ids = set()
+
+    def compute(self, inputs, t):
+        self.input_ids.add(id(inputs[0]))
+        self.time_ids.add(id(t))
+        return [len(self.input_ids), len(self.time_ids)]
+
+
+class OpenDescriptors:
+    """Outputs the number of file descriptors open in the process running it."""
+
+    def __init__(self, config):
+        pass
+
+    def compute(self, inputs, t):
+        import os
+        return [len(os.listdir("/proc/self/fd"))]
+
+
+class PureIntegrator:
+    """dx/dt = u, output = x. Wrongly declares pure, the bridge must not trust it."""
+
+    pure = "inputs"
+
+    def __init__(self, config):
+        self.x = 0.0
+
+    def get_states(self):
+        return [self.x]
+
+    def set_states(self, x):
+        self.x = x[0]
+
+    def derivatives(self, t, x, u):
+        return [u[0]]
+
+    def compute(self, inputs, t):
+        return [self.x]
+
+
+class PureSquare:
+    """outputs = inputs squared, depends on the inputs only."""
+
+    pure = "inputs"
+
+    def __init__(self, config):
+        pass
+
+    def compute(self, inputs, t):
+        return [x * x for x in inputs]
+
+
+class PureScaledSquare:
+    """outputs = Gain * inputs squared, depends on the inputs only; Gain can be updated live."""
+
+    pure = "inputs"
+
+    def __init__(self, config):
+        self.gain = config.get("Gain", 1.0)
+
+    def compute(self, inputs, t):
+        return [self.gain * x * x for x in inputs]
+
+    def update_configuration(self, key, value):
+        if key != "Gain":
+            return False
+        self.gain = value
+        return True
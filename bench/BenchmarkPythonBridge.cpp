@@ -0,0 +1,193 @@
+/*
+ * Benchmarks SimulationBlockPython in isolation, without a simulation engine.
+ *
+ * Usage: BenchmarkPythonBridge <directory with bench_blocks.py> [results.csv]
+ *
+ * Every result is one CSV row:
+ *   benchmark,signal_type,exchange,python_class,ports,blocks,iterations,ns_per_call
+ */
+
+#include <chrono>
+#include <complex>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <PySysLinkBase/ConfigurationValue.h>
+#include <PySysLinkBase/IBlockEventsHandler.h>
+#include <PySysLinkBase/ISimulationBlock.h>
+
+#include "BlockFactoryPython.h"
+
+using namespace BlockTypeSupports::BasicPythonSupport;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+
+std::ostringstream results;
+
+// Benchmarked blocks raise no events, nothing needs to receive them
+class NullBlockEventsHandler : public PySysLinkBase::IBlockEventsHandler
+{
+public:
+    void BlockEventCallback(const std::shared_ptr<PySysLinkBase::BlockEvent> blockEvent) const override {}
+    void RegisterBlockEventCallbacks(const std::function<void (std::shared_ptr<PySysLinkBase::BlockEvent>)> blockEventCallback) override {}
+};
+
+const auto eventsHandler = std::make_shared<NullBlockEventsHandler>();
+
+void Emit(const std::string& benchmark, const std::string& signalType, const std::string& exchange, const std::string& pythonClass,
+          int ports, int blocks, long iterations, double nanosecondsPerCall)
+{
+    results << benchmark << ',' << signalType << ',' << exchange << ',' << pythonClass << ','
+            << ports << ',' << blocks << ',' << iterations << ',' << nanosecondsPerCall << '\n';
+    std::cerr << benchmark << ' ' << signalType << ' ' << exchange << ' ' << pythonClass
+              << " ports=" << ports << " blocks=" << blocks << ": " << nanosecondsPerCall << " ns/call" << std::endl;
+}
+
+std::map<std::string, PySysLinkBase::ConfigurationValue> BlockConfiguration(const std::string& pythonClass, const std::string& signalType,
+                                                                            const std::string& exchange, int ports)
+{
+    return {
+        {"PythonModule", std::string("bench_blocks")},
+        {"PythonClass", pythonClass},
+        {"SignalType", signalType},
+        {"PortExchange", exchange},
+        {"InputPortNumber", ports},
+        {"OutputPortNumber", ports},
+    };
+}
+
+double SecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Runs steps over all blocks for at least minimumSeconds, returns ns per block call
+double TimeSteps(const std::vector<std::shared_ptr<PySysLinkBase::ISimulationBlock>>& blocks, long& iterations, double minimumSeconds = 0.2)
+{
+    // the bridge ignores the sample time argument, any of the blocks' own will do
+    auto sampleTime = blocks.front()->GetSampleTime();
+
+    for (int warmup = 0; warmup < 10; ++warmup)
+    {
+        for (auto& block : blocks) block->_ComputeOutputsOfBlock(sampleTime, 0.0);
+    }
+
+    iterations = 0;
+    auto start = Clock::now();
+    double elapsed = 0.0;
+    while (elapsed < minimumSeconds)
+    {
+        for (int k = 0; k < 100; ++k, ++iterations)
+        {
+            double t = 1e-3 * iterations;
+            for (auto& block : blocks) block->_ComputeOutputsOfBlock(sampleTime, t);
+        }
+        elapsed = SecondsSince(start);
+    }
+    return 1e9 * elapsed / double(iterations * blocks.size());
+}
+
+bool NumpyAvailable()
+{
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    PyObject* numpy = PyImport_ImportModule("numpy");
+    bool available = numpy != nullptr;
+    Py_XDECREF(numpy);
+    PyErr_Clear();
+    PyGILState_Release(gstate);
+    return available;
+}
+
+void BenchmarkPortCounts(BlockFactoryPython& factory, const std::string& signalType, const std::string& exchange, const std::string& pythonClass)
+{
+    for (int ports : {1, 4, 16, 64, 256, 1024})
+    {
+        std::vector<std::shared_ptr<PySysLinkBase::ISimulationBlock>> blocks = {
+            factory.CreateBlock(BlockConfiguration(pythonClass, signalType, exchange, ports), eventsHandler)
+        };
+        long iterations;
+        double ns = TimeSteps(blocks, iterations);
+        Emit("per_call", signalType, exchange, pythonClass, ports, 1, iterations, ns);
+    }
+}
+
+void BenchmarkBlockCounts(BlockFactoryPython& factory, const std::string& signalType)
+{
+    for (int blockCount : {1, 10, 100, 1000})
+    {
+        std::vector<std::shared_ptr<PySysLinkBase::ISimulationBlock>> blocks;
+        auto start = Clock::now();
+        for (int i = 0; i < blockCount; ++i)
+        {
+            blocks.push_back(factory.CreateBlock(BlockConfiguration("Passthrough", signalType, "List", 1), eventsHandler));
+        }
+        Emit("construction", signalType, "List", "Passthrough", 1, blockCount, blockCount, 1e9 * SecondsSince(start) / blockCount);
+
+        long iterations;
+        double ns = TimeSteps(blocks, iterations);
+        Emit("block_count", signalType, "List", "Passthrough", 1, blockCount, iterations, ns);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <directory with bench_blocks.py> [results.csv]" << std::endl;
+        return 2;
+    }
+
+    spdlog::set_level(spdlog::level::warn);
+    results << "benchmark,signal_type,exchange,python_class,ports,blocks,iterations,ns_per_call\n";
+
+    std::map<std::string, PySysLinkBase::ConfigurationValue> pluginConfiguration = {
+        {"BasicPythonSupport/pythonModulePaths", std::vector<std::string>{argv[1]}},
+    };
+
+    // first factory pays for interpreter start and the first import
+    auto start = Clock::now();
+    BlockFactoryPython factory(pluginConfiguration);
+    auto firstBlock = factory.CreateBlock(BlockConfiguration("Passthrough", "Double", "List", 1), eventsHandler);
+    Emit("interpreter_and_import", "Double", "List", "Passthrough", 1, 1, 1, 1e9 * SecondsSince(start));
+    firstBlock.reset();
+
+    bool numpy = NumpyAvailable();
+    if (!numpy)
+    {
+        std::cerr << "numpy not importable, skipping NumpyHeavy benchmarks" << std::endl;
+    }
+
+    for (const std::string signalType : {"Double", "Complex"})
+    {
+        BenchmarkPortCounts(factory, signalType, "List", "Passthrough");
+        BenchmarkPortCounts(factory, signalType, "Buffer", "PassthroughBuffer");
+        if (numpy)
+        {
+            BenchmarkPortCounts(factory, signalType, "Buffer", "NumpyHeavy");
+        }
+        BenchmarkBlockCounts(factory, signalType);
+    }
+
+    if (argc > 2)
+    {
+        std::ofstream out(argv[2]);
+        out << results.str();
+        std::cerr << "Results written to " << argv[2] << std::endl;
+    }
+    else
+    {
+        std::cout << results.str();
+    }
+    return 0;
+}
@@ -0,0 +1,37 @@
+"""Python blocks exercised by BenchmarkPythonBridge."""
+
+
+class Passthrough:
+    """Trivial list-exchange block: outputs = inputs."""
+
+    def __init__(self, config):
+        pass
+
+    def compute(self, inputs, t):
+        return inputs
+
+
+class PassthroughBuffer:
+    """Trivial buffer-exchange block: outputs = inputs."""
+
+    def __init__(self, config):
+        pass
+
+    def compute(self, inputs, outputs, t):
+        # byte views, slice assignment is not implemented for complex formats
+        outputs.cast("B")[:] = inputs.cast("B")
+
+
+class NumpyHeavy:
+    """Buffer-exchange block doing a round trip through the FFT."""
+
+    def __init__(self, config):
+        import numpy
+        self.np = numpy
+
+    def compute(self, inputs, outputs, t):
+        np = self.np
+        x = np.asarray(inputs)
+        y = np.fft.ifft(np.fft.fft(x) * np.exp(-1j * t))
+        out = np.asarray(outputs)
+        out[:] = y if np.iscomplexobj(out) else y.real
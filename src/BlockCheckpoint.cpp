@@ -0,0 +1,346 @@
+#include "BlockCheckpoint.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <spdlog/spdlog.h>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+namespace
+{
+
+constexpr char CheckpointMagic[8] = {'P', 'S', 'L', 'C', 'K', 'P', 'T', '\0'};
+constexpr uint32_t CheckpointVersion = 1;
+
+template <typename V>
+void WriteValue(std::ofstream& out, const V& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(V));
+}
+
+void WriteBytes(std::ofstream& out, const void* data, uint64_t size)
+{
+    WriteValue(out, size);
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+}
+
+template <typename V>
+V ReadValue(std::ifstream& in, const std::string& path)
+{
+    V value;
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(V)))
+    {
+        throw std::runtime_error("CheckpointRegistry: " + path + " is truncated");
+    }
+    return value;
+}
+
+uint64_t RemainingBytes(std::ifstream& in)
+{
+    std::streampos position = in.tellg();
+    in.seekg(0, std::ios::end);
+    uint64_t remaining = static_cast<uint64_t>(in.tellg() - position);
+    in.seekg(position);
+    return remaining;
+}
+
+template <typename Container>
+void ReadBytes(std::ifstream& in, const std::string& path, Container& bytes)
+{
+    uint64_t size = ReadValue<uint64_t>(in, path);
+    // larger than what is left of the file: corrupt, not worth an allocation
+    if (size > RemainingBytes(in))
+    {
+        throw std::runtime_error("CheckpointRegistry: " + path + " is truncated");
+    }
+    bytes.resize(size);
+    if (size > 0 && !in.read(reinterpret_cast<char*>(&bytes[0]), static_cast<std::streamsize>(size)))
+    {
+        throw std::runtime_error("CheckpointRegistry: " + path + " is truncated");
+    }
+}
+
+PyObject* PickleFunction(const char* name)
+{
+    PyObject* pyPickle = PyImport_ImportModule("pickle");
+    if (!pyPickle) return nullptr;
+    PyObject* pyFunction = PyObject_GetAttrString(pyPickle, name);
+    Py_DECREF(pyPickle);
+    return pyFunction;
+}
+
+} // namespace
+
+std::string PicklePythonState(PyObject* pyInstance)
+{
+    PyObject* pyState = PyObject_HasAttrString(pyInstance, "get_state")
+        ? PyObject_CallMethod(pyInstance, "get_state", nullptr)
+        : PyObject_GetAttrString(pyInstance, "__dict__");
+    PyObject* pyDumps = pyState ? PickleFunction("dumps") : nullptr;
+    PyObject* pyBytes = nullptr;
+    if (pyDumps)
+    {
+        PyObject* pyProtocol = PyLong_FromLong(-1); // highest protocol
+        pyBytes = PyObject_CallFunctionObjArgs(pyDumps, pyState, pyProtocol, NULL);
+        Py_DECREF(pyProtocol);
+        Py_DECREF(pyDumps);
+    }
+    Py_XDECREF(pyState);
+
+    if (!pyBytes || !PyBytes_Check(pyBytes))
+    {
+        Py_XDECREF(pyBytes);
+        PyErr_Print();
+        throw std::runtime_error("PicklePythonState: state of the python block does not pickle, define get_state()/set_state()");
+    }
+    std::string state(PyBytes_AS_STRING(pyBytes), static_cast<size_t>(PyBytes_GET_SIZE(pyBytes)));
+    Py_DECREF(pyBytes);
+    return state;
+}
+
+void UnpicklePythonState(PyObject* pyInstance, const std::string& state)
+{
+    PyObject* pyLoads = PickleFunction("loads");
+    PyObject* pyBytes = PyBytes_FromStringAndSize(state.data(), static_cast<Py_ssize_t>(state.size()));
+    PyObject* pyState = pyLoads && pyBytes ? PyObject_CallFunctionObjArgs(pyLoads, pyBytes, NULL) : nullptr;
+    Py_XDECREF(pyBytes);
+    Py_XDECREF(pyLoads);
+
+    bool restored = false;
+    if (pyState && PyObject_HasAttrString(pyInstance, "set_state"))
+    {
+        PyObject* pyResult = PyObject_CallMethod(pyInstance, "set_state", "O", pyState);
+        restored = pyResult != nullptr;
+        Py_XDECREF(pyResult);
+    }
+    else if (pyState && PyDict_Check(pyState))
+    {
+        PyObject* pyDict = PyObject_GetAttrString(pyInstance, "__dict__");
+        restored = pyDict && PyDict_Update(pyDict, pyState) == 0;
+        Py_XDECREF(pyDict);
+    }
+    Py_XDECREF(pyState);
+
+    if (!restored)
+    {
+        if (PyErr_Occurred()) PyErr_Print();
+        throw std::runtime_error("UnpicklePythonState: could not restore the state of the python block");
+    }
+}
+
+CheckpointRegistry& CheckpointRegistry::Instance()
+{
+    static CheckpointRegistry instance;
+    return instance;
+}
+
+void CheckpointRegistry::Configure(const std::string& savePath, double saveTime, const std::string& restorePath)
+{
+    std::vector<BlockCheckpointRecord> records;
+    if (!restorePath.empty())
+    {
+        records = Read(restorePath);
+        spdlog::info("Restoring {} python blocks from checkpoint {}", records.size(), restorePath);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    this->savePath = savePath;
+    this->saveTime = savePath.empty() ? std::numeric_limits<double>::infinity() : saveTime;
+    stored.clear();
+    skipped.clear();
+    restored.clear();
+    for (auto& record : records)
+    {
+        std::string blockId = record.blockId;
+        restored[blockId] = std::move(record);
+    }
+}
+
+void CheckpointRegistry::Register(ICheckpointableBlock* block)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string blockId = block->GetCheckpointId();
+    for (ICheckpointableBlock* other : blocks)
+    {
+        // ids only matter to a checkpoint being written or restored
+        if (savePath.empty() && restored.empty()) break;
+        if (other->GetCheckpointId() == blockId)
+        {
+            spdlog::warn("CheckpointRegistry: two python blocks have the id {}, their checkpoint records collide", blockId);
+            break;
+        }
+    }
+    blocks.push_back(block);
+}
+
+void CheckpointRegistry::Unregister(ICheckpointableBlock* block)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    blocks.erase(std::remove(blocks.begin(), blocks.end(), block), blocks.end());
+}
+
+void CheckpointRegistry::Store(BlockCheckpointRecord record)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (savePath.empty()) return;
+
+    std::string blockId = record.blockId;
+    stored[blockId] = std::move(record);
+    if (stored.size() + skipped.size() >= blocks.size())
+    {
+        WriteStored();
+    }
+}
+
+void CheckpointRegistry::Skip(const std::string& blockId)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (savePath.empty()) return;
+
+    skipped.insert(blockId);
+    if (!stored.empty() && stored.size() + skipped.size() >= blocks.size())
+    {
+        WriteStored();
+    }
+}
+
+const BlockCheckpointRecord* CheckpointRegistry::FindRestored(const std::string& blockId) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = restored.find(blockId);
+    return found == restored.end() ? nullptr : &found->second;
+}
+
+void CheckpointRegistry::SaveNow(const std::string& path, double time)
+{
+    std::vector<ICheckpointableBlock*> current;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current = blocks;
+    }
+
+    // outside the lock, blocks enter their interpreter to pickle their state
+    std::vector<BlockCheckpointRecord> records;
+    for (ICheckpointableBlock* block : current)
+    {
+        records.push_back(block->SaveCheckpoint(time));
+    }
+    Write(path, records);
+    spdlog::info("Checkpoint of {} python blocks at t = {:g} written to {}", records.size(), time, path);
+}
+
+void CheckpointRegistry::Flush()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (savePath.empty() || saveTime == std::numeric_limits<double>::infinity()) return;
+
+    if (stored.empty())
+    {
+        spdlog::warn("CheckpointRegistry: no python block reached t = {:g}, {} not written", saveTime, savePath);
+        saveTime = std::numeric_limits<double>::infinity();
+        return;
+    }
+    // blocks may already be gone, their count says nothing here
+    spdlog::warn("CheckpointRegistry: only {} python blocks reached t = {:g}, the others are left out", stored.size(), saveTime);
+    WriteStored();
+}
+
+void CheckpointRegistry::WriteStored()
+{
+    std::vector<BlockCheckpointRecord> records;
+    for (const auto& entry : stored)
+    {
+        records.push_back(entry.second);
+    }
+    // from a simulation step or the factory destructor, a failed write must not end the run
+    try {
+        Write(savePath, records);
+        spdlog::info("Checkpoint of {} python blocks at t = {:g} written to {}", records.size(), saveTime, savePath);
+    } catch (std::exception& e) {
+        spdlog::error("CheckpointRegistry: checkpoint at t = {:g} not written: {}", saveTime.load(), e.what());
+    }
+
+    // one time-triggered checkpoint per run
+    saveTime = std::numeric_limits<double>::infinity();
+    stored.clear();
+    skipped.clear();
+}
+
+void CheckpointRegistry::Write(const std::string& path, const std::vector<BlockCheckpointRecord>& records)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        throw std::runtime_error("CheckpointRegistry: could not open " + path);
+    }
+
+    out.write(CheckpointMagic, sizeof(CheckpointMagic));
+    WriteValue(out, CheckpointVersion);
+    WriteValue(out, static_cast<uint32_t>(records.size()));
+    for (const auto& record : records)
+    {
+        WriteBytes(out, record.blockId.data(), record.blockId.size());
+        WriteValue(out, record.time);
+        WriteBytes(out, record.elementFormat.data(), record.elementFormat.size());
+        WriteValue(out, record.elementSize);
+        WriteValue(out, record.inputCount);
+        WriteValue(out, record.outputCount);
+        WriteBytes(out, record.inputs.data(), record.inputs.size());
+        WriteBytes(out, record.outputs.data(), record.outputs.size());
+        WriteValue(out, record.memoTime);
+        WriteValue(out, record.flags);
+        WriteBytes(out, record.pythonState.data(), record.pythonState.size());
+    }
+    if (!out.flush())
+    {
+        throw std::runtime_error("CheckpointRegistry: could not write " + path);
+    }
+}
+
+std::vector<BlockCheckpointRecord> CheckpointRegistry::Read(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        throw std::runtime_error("CheckpointRegistry: could not open " + path);
+    }
+
+    char magic[sizeof(CheckpointMagic)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, CheckpointMagic, sizeof(magic)) != 0 ||
+        ReadValue<uint32_t>(in, path) != CheckpointVersion)
+    {
+        throw std::runtime_error("CheckpointRegistry: " + path + " is not a version " + std::to_string(CheckpointVersion) + " checkpoint");
+    }
+
+    uint32_t count = ReadValue<uint32_t>(in, path);
+    // every record holds at least its fixed fields and five empty byte strings
+    const uint64_t minimumRecordBytes = sizeof(double) * 2 + sizeof(uint32_t) * 4 + sizeof(uint64_t) * 5;
+    if (count > RemainingBytes(in) / minimumRecordBytes)
+    {
+        throw std::runtime_error("CheckpointRegistry: " + path + " is truncated");
+    }
+    std::vector<BlockCheckpointRecord> records;
+    records.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        BlockCheckpointRecord& record = records.emplace_back();
+        ReadBytes(in, path, record.blockId);
+        record.time = ReadValue<double>(in, path);
+        ReadBytes(in, path, record.elementFormat);
+        record.elementSize = ReadValue<uint32_t>(in, path);
+        record.inputCount = ReadValue<uint32_t>(in, path);
+        record.outputCount = ReadValue<uint32_t>(in, path);
+        ReadBytes(in, path, record.inputs);
+        ReadBytes(in, path, record.outputs);
+        record.memoTime = ReadValue<double>(in, path);
+        record.flags = ReadValue<uint32_t>(in, path);
+        ReadBytes(in, path, record.pythonState);
+    }
+    return records;
+}
+
+} // namespace BlockTypeSupports::BasicPythonSupport
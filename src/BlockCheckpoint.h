@@ -0,0 +1,120 @@
+#ifndef SRC_BLOCK_CHECKPOINT_H
+#define SRC_BLOCK_CHECKPOINT_H
+
+#pragma once
+
+#include <Python.h>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+// State of one block as it enters its call at time
+struct BlockCheckpointRecord
+{
+    std::string blockId;
+    double time = 0.0;
+    std::string elementFormat;          // struct format of one element, e.g. "d" or "Zd"
+    uint32_t elementSize = 0;
+    uint32_t inputCount = 0;            // elements, over all input ports
+    uint32_t outputCount = 0;           // elements, over all output ports
+    std::vector<unsigned char> inputs;  // last inputs read, what memoized outputs belong to
+    std::vector<unsigned char> outputs; // held by the output ports
+    double memoTime = 0.0;
+    uint32_t flags = 0;                 // block specific, see SimulationBlockPython
+    std::string pythonState;            // pickle of get_state(), or of the instance __dict__
+};
+
+// Block side of a checkpoint, implemented by SimulationBlockPython
+class ICheckpointableBlock
+{
+public:
+    virtual ~ICheckpointableBlock() = default;
+
+    virtual std::string GetCheckpointId() const = 0;
+
+    // State as of the start of a call at time
+    virtual BlockCheckpointRecord SaveCheckpoint(double time) = 0;
+};
+
+// pickle.dumps(instance.get_state()) if the instance defines it, pickle.dumps(instance.__dict__) otherwise.
+// Caller holds the GIL, throws std::runtime_error if the state does not pickle.
+std::string PicklePythonState(PyObject* pyInstance);
+
+// instance.set_state(pickle.loads(state)) if the instance defines it, instance.__dict__.update(...) otherwise.
+// Caller holds the GIL, throws std::runtime_error on failure.
+void UnpicklePythonState(PyObject* pyInstance, const std::string& state);
+
+/*
+ * Checkpoints of every in-process python block, to restart a simulation (or fork what-if runs)
+ * from a warmed-up state instead of from t = 0.
+ *
+ * Plugin configuration:
+ *   BasicPythonSupport/checkpointPath:    file the checkpoint is written to
+ *   BasicPythonSupport/checkpointTime:    each block records its state on its first major step
+ *                                         at t >= checkpointTime; the file is written once every
+ *                                         block has, or at the end of the run with those that did
+ *   BasicPythonSupport/restoreCheckpoint: checkpoint restored into each block, matched by block id,
+ *                                         right after the block is created and initialized
+ * The engine restarts its own clock and the states of native blocks; a restored python block
+ * only holds the state it had entering the recorded call.
+ *
+ * File: "PSLCKPT" magic, version and record count, then per record the block id, layout,
+ * time, inputs, outputs and python state, in native byte order.
+ */
+class CheckpointRegistry
+{
+public:
+    static CheckpointRegistry& Instance();
+
+    // Reads the restore checkpoint, if any, throws std::runtime_error if it cannot be read
+    void Configure(const std::string& savePath, double saveTime, const std::string& restorePath);
+
+    // Infinite while no time-triggered checkpoint is pending
+    double GetSaveTime() const { return saveTime.load(std::memory_order_relaxed); }
+
+    void Register(ICheckpointableBlock* block);
+    void Unregister(ICheckpointableBlock* block);
+
+    // Time-triggered record of a block, the file is written once every registered block stored one
+    void Store(BlockCheckpointRecord record);
+
+    // A block whose state could not be saved, left out of the time-triggered checkpoint
+    void Skip(const std::string& blockId);
+
+    // Record restored into the block with this id, null if there is none
+    const BlockCheckpointRecord* FindRestored(const std::string& blockId) const;
+
+    // Asks every registered block for its state now and writes them to path. Call between steps.
+    void SaveNow(const std::string& path, double time);
+
+    // Writes the pending time-triggered checkpoint with the blocks that reached checkpointTime.
+    // Logs rather than throws, it runs from the factory destructor.
+    void Flush();
+
+    static void Write(const std::string& path, const std::vector<BlockCheckpointRecord>& records);
+    static std::vector<BlockCheckpointRecord> Read(const std::string& path);
+
+private:
+    mutable std::mutex mutex;
+    std::string savePath;
+    std::atomic<double> saveTime{std::numeric_limits<double>::infinity()};
+    std::vector<ICheckpointableBlock*> blocks;
+    std::map<std::string, BlockCheckpointRecord> stored;
+    std::set<std::string> skipped;
+    std::map<std::string, BlockCheckpointRecord> restored;
+
+    void WriteStored();
+};
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_BLOCK_CHECKPOINT_H
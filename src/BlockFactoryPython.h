@@ -6,7 +6,18 @@
 #include <PySysLinkBase/ConfigurationValue.h>
 
 #include "SimulationBlockPython.h"
+#include "SimulationBlockPythonContinuous.h"
+#include "SubInterpreterPool.h"
+#include "SimulationBlockPythonProcess.h"
+#include "ProcessWorkerPool.h"
+#include "FusedBlockGroup.h"
+#include "BlockInstrumentation.h"
+#include "BlockCheckpoint.h"
+#include "PythonClassCache.h"
 #include <Python.h>
+#include <algorithm>
+#include <chrono>
+#include <limits>
 #include <memory>
 #include <string>
 #include <map>
@@ -20,14 +31,18 @@ class BlockFactoryPython : public PySysLinkBase::IBlockFactory
 {
 public:
     BlockFactoryPython(std::map<std::string, PySysLinkBase::ConfigurationValue> pluginConfiguration)
+        : pluginConfiguration(pluginConfiguration), classCache(std::make_shared<PythonClassCache>())
     {
+        auto phaseStart = std::chrono::steady_clock::now();
+
         // Initialize Python interpreter only once
         if (!Py_IsInitialized())
         {
             InitializePython(pluginConfiguration);
         }
+        double interpreterSeconds = SecondsSince(phaseStart);
+        phaseStart = std::chrono::steady_clock::now();
 
-        std::vector<std::string> pythonModulePaths;
         try {
             pythonModulePaths = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::vector<std::string>>("BasicPythonSupport/pythonModulePaths", pluginConfiguration);
         } catch (std::out_of_range&) {
@@ -46,8 +61,192 @@ public:
             }
             Py_DECREF(path);
         }
-            
+
+        Py_ssize_t pathCount = PyList_Size(sysPath);
+        spdlog::debug("Python sys.path has {} entries:", pathCount);
+        for (Py_ssize_t i = 0; i < pathCount; ++i)
+        {
+            const char* pathStr = PyUnicode_AsUTF8(PyList_GetItem(sysPath, i)); // borrowed reference
+            if (pathStr)
+            {
+                spdlog::debug("  [{}] {}", i, pathStr);
+            }
+        }
+        double sysPathSeconds = SecondsSince(phaseStart);
+
+        // optional per-block hot path instrumentation
+        bool instrumentation = false;
+        try {
+            instrumentation = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<bool>("BasicPythonSupport/instrumentation", pluginConfiguration);
+        } catch (std::out_of_range&) {
+            // default: disabled
+        }
+        // optional: python heap usage of sampled compute() calls, reported with the timings
+        bool memoryTracking = false;
+        try {
+            memoryTracking = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<bool>("BasicPythonSupport/memoryTracking", pluginConfiguration);
+        } catch (std::out_of_range&) {
+            // default: disabled
+        }
+        if (instrumentation || memoryTracking)
+        {
+            std::string reportPath;
+            try {
+                reportPath = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("BasicPythonSupport/instrumentationReport", pluginConfiguration);
+            } catch (std::out_of_range&) {
+                // log summary only
+            }
+            InstrumentationRegistry::Instance().Enable(reportPath);
+        }
+        int memorySampleInterval = 100;
+        int memoryGrowthWarning = 1 << 20;
+        try {
+            memorySampleInterval = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<int>("BasicPythonSupport/memorySampleInterval", pluginConfiguration);
+        } catch (std::out_of_range&) {
+            // default: every 100th call
+        }
+        try {
+            memoryGrowthWarning = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<int>("BasicPythonSupport/memoryGrowthWarning", pluginConfiguration);
+        } catch (std::out_of_range&) {
+            // default: 1 MiB
+        }
+
+        // optional: checkpoint written at checkpointTime, and one restored into the blocks as they are created
+        std::string checkpointPath;
+        double checkpointTime = std::numeric_limits<double>::infinity();
+        std::string restoreCheckpoint;
+        try {
+            checkpointPath = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("BasicPythonSupport/checkpointPath", pluginConfiguration);
+        } catch (std::out_of_range&) {
+            // default: no time-triggered checkpoint
+        }
+        try {
+            checkpointTime = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<double>("BasicPythonSupport/checkpointTime", pluginConfiguration);
+        } catch (std::out_of_range&) {
+            // default: only on request, see BasicPythonSupportSaveCheckpoint()
+        }
+        try {
+            restoreCheckpoint = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("BasicPythonSupport/restoreCheckpoint", pluginConfiguration);
+        } catch (std::out_of_range&) {
+            // default: start from scratch
+        }
+        if (!checkpointPath.empty() || !restoreCheckpoint.empty())
+        {
+            CheckpointRegistry::Instance().Configure(checkpointPath, checkpointTime, restoreCheckpoint);
+        }
+
+        // optional: compile-time port count specializations for small scalar blocks, default on
+        // in builds with BASIC_PYTHON_FIXED_PORT_SPECIALIZATIONS (CMake option of the same name)
+        try {
+            fixedPortSpecializations = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<bool>("BasicPythonSupport/fixedPortSpecializations", pluginConfiguration);
+#ifndef BASIC_PYTHON_FIXED_PORT_SPECIALIZATIONS
+            if (fixedPortSpecializations)
+            {
+                spdlog::warn("BasicPythonSupport/fixedPortSpecializations ignored, the plugin was built without BASIC_PYTHON_FIXED_PORT_SPECIALIZATIONS");
+            }
+#endif
+        } catch (std::out_of_range&) {
+            // default: enabled
+        }
+
+        // optional: blocks receive the shared lazily converted, read-only configuration mapping instead of
+        // a plain dict; opt-in, since blocks assigning to or popping from their config, or checking
+        // isinstance(config, dict), break on it
+        bool lazyConfiguration = false;
+        try {
+            lazyConfiguration = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<bool>("BasicPythonSupport/lazyConfiguration", pluginConfiguration);
+        } catch (std::out_of_range&) {
+            // default: disabled
+        }
+        if (lazyConfiguration)
+        {
+            configurationCache = std::make_shared<ConfigurationMappingCache>();
+        }
+
+        // optional sub-interpreters with their own GIL
+        int subInterpreterCount = 0;
+        try {
+            subInterpreterCount = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<int>("BasicPythonSupport/subInterpreterCount", pluginConfiguration);
+        } catch (std::out_of_range&) {
+            // default: main interpreter only
+        }
+        std::string subInterpreterMapping = "RoundRobin";
+        try {
+            subInterpreterMapping = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("BasicPythonSupport/subInterpreterMapping", pluginConfiguration);
+        } catch (std::out_of_range&) {
+            // default: RoundRobin
+        }
+
+        phaseStart = std::chrono::steady_clock::now();
+        if (subInterpreterCount > 0)
+        {
+            if (SubInterpreterPool::IsSupported())
+            {
+                try {
+                    subInterpreterPool = std::make_unique<SubInterpreterPool>(subInterpreterCount, subInterpreterMapping, pythonModulePaths);
+                } catch (...) {
+                    PyGILState_Release(gstate);
+                    throw;
+                }
+            }
+            else
+            {
+                spdlog::warn("Python {} does not support sub-interpreters with their own GIL, running all blocks on the main interpreter", PY_VERSION);
+            }
+        }
+        double subInterpreterSeconds = SecondsSince(phaseStart);
+
+        // tracemalloc counters are process wide, other interpreters would show up in every sample
+        if (memoryTracking && subInterpreterPool)
+        {
+            spdlog::warn("BasicPythonSupport/memoryTracking is not supported with sub-interpreters, python heap usage is not tracked");
+        }
+        else if (memoryTracking)
+        {
+            InstrumentationRegistry::Instance().EnableMemoryTracking(static_cast<uint32_t>(std::max(memorySampleInterval, 1)), memoryGrowthWarning);
+        }
+
+        // optional: modules imported up front on every interpreter, instead of by the first block using them
+        std::vector<std::string> preloadModules;
+        try {
+            preloadModules = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::vector<std::string>>("BasicPythonSupport/preloadModules", pluginConfiguration);
+        } catch (std::out_of_range&) {
+            // default: import on first use
+        }
+
+        phaseStart = std::chrono::steady_clock::now();
+        classCache->Preload(MainInterpreterExecutor::Instance(), preloadModules);
+        if (subInterpreterPool)
+        {
+            for (const auto& executor : subInterpreterPool->GetExecutors())
+            {
+                classCache->Preload(executor, preloadModules);
+            }
+        }
+        double preloadSeconds = SecondsSince(phaseStart);
+
         PyGILState_Release(gstate);
+
+        spdlog::info("Python startup: interpreter {:.1f} ms, sys.path {:.1f} ms, sub-interpreters {:.1f} ms, preload of {} modules {:.1f} ms",
+                     1e3 * interpreterSeconds, 1e3 * sysPathSeconds, 1e3 * subInterpreterSeconds, preloadModules.size(), 1e3 * preloadSeconds);
+    }
+
+    ~BlockFactoryPython()
+    {
+        if (blockCount > 0)
+        {
+            classCache->LogStatistics();
+            if (configurationCache) configurationCache->LogStatistics();
+            spdlog::info("Created {} in-process Python blocks in {:.1f} ms", blockCount, 1e3 * blockCreationSeconds);
+        }
+        for (const auto& [name, group] : fusedGroups)
+        {
+            spdlog::info("Fused group {}: chain of up to {} blocks evaluated {} times", name, group->GetLongestChain(), group->GetEvaluationCount());
+        }
+
+        // end of run
+        CheckpointRegistry::Instance().Flush();
+        InstrumentationRegistry::Instance().Report();
     }
 
     std::shared_ptr<PySysLinkBase::ISimulationBlock>
@@ -64,22 +263,261 @@ public:
             // default: Double
         }
 
-        spdlog::debug("Creating BasicPython block with signal type {}", signalType);
+        std::string executionBackend = "InProcess";
+        try
+        {
+            executionBackend = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("ExecutionBackend", blockConfiguration);
+        }
+        catch (std::out_of_range&)
+        {
+            // default: InProcess
+        }
 
+        // optional: chain of blocks computed under one GIL acquisition, see FusedBlockGroup
+        std::string fusionGroup;
+        try
+        {
+            fusionGroup = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("FusionGroup", blockConfiguration);
+        }
+        catch (std::out_of_range&)
+        {
+            // default: not fused
+        }
+        int fusionIndex = 0;
+        try
+        {
+            fusionIndex = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<int>("FusionIndex", blockConfiguration);
+        }
+        catch (std::out_of_range&)
+        {
+            // default: 0
+        }
+
+        spdlog::debug("Creating BasicPython block with signal type {} on backend {}", signalType, executionBackend);
+
+        if (executionBackend == "Process")
+        {
+            if (!fusionGroup.empty())
+            {
+                spdlog::warn("FusionGroup {} ignored for a block on ExecutionBackend Process", fusionGroup);
+            }
+            return CreateProcessBlock(blockConfiguration, eventHandler, signalType);
+        }
+        else if (executionBackend != "InProcess")
+        {
+            throw std::invalid_argument("Unsupported ExecutionBackend: " + executionBackend);
+        }
+
+        std::shared_ptr<IPythonExecutor> executor = MainInterpreterExecutor::Instance();
+        std::shared_ptr<FusedBlockGroup> group;
+        if (!fusionGroup.empty())
+        {
+            auto found = fusedGroups.find(fusionGroup);
+            if (found != fusedGroups.end())
+            {
+                group = found->second;
+            }
+        }
+        if (group)
+        {
+            // every member lives on the interpreter of the group's first block
+            executor = group->GetExecutor();
+        }
+        else if (subInterpreterPool)
+        {
+            executor = subInterpreterPool->ExecutorForBlock(blockConfiguration);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::shared_ptr<PySysLinkBase::ISimulationBlock> block;
         if (signalType == "Double")
         {
-            return std::make_shared<SimulationBlockPython<double>>(blockConfiguration, eventHandler);
+            block = CreateInProcessBlock<double>(blockConfiguration, eventHandler, executor);
         }
         else if (signalType == "Complex")
         {
-            return std::make_shared<SimulationBlockPython<std::complex<double>>>(blockConfiguration, eventHandler);
+            block = CreateInProcessBlock<std::complex<double>>(blockConfiguration, eventHandler, executor);
+        }
+        else if (signalType == "Float")
+        {
+            block = CreateInProcessBlock<float>(blockConfiguration, eventHandler, executor);
+        }
+        else if (signalType == "Int64")
+        {
+            block = CreateInProcessBlock<int64_t>(blockConfiguration, eventHandler, executor);
+        }
+        else if (signalType == "Bool")
+        {
+            block = CreateInProcessBlock<bool>(blockConfiguration, eventHandler, executor);
+        }
+        else if (signalType == "DoubleVector")
+        {
+            block = CreateInProcessBlock<std::vector<double>>(blockConfiguration, eventHandler, executor);
+        }
+        else if (signalType == "ComplexVector")
+        {
+            block = CreateInProcessBlock<std::vector<std::complex<double>>>(blockConfiguration, eventHandler, executor);
         }
         else
         {
             throw std::invalid_argument("Unsupported SignalType: " + signalType);
         }
+        blockCreationSeconds += SecondsSince(start);
+        ++blockCount;
+
+        if (!fusionGroup.empty())
+        {
+            JoinFusedGroup(block, fusionGroup, fusionIndex, group ? group : CreateFusedGroup(fusionGroup, executor));
+        }
+        return block;
     }
 private:
+    std::map<std::string, PySysLinkBase::ConfigurationValue> pluginConfiguration;
+    std::vector<std::string> pythonModulePaths;
+    std::unique_ptr<SubInterpreterPool> subInterpreterPool;
+    std::unique_ptr<ProcessWorkerPool> processWorkerPool;
+    // declared after the pools so cached objects are released before the interpreters go away
+    std::shared_ptr<PythonClassCache> classCache;
+    std::shared_ptr<ConfigurationMappingCache> configurationCache; // null: plain dict per block
+    std::map<std::string, std::shared_ptr<FusedBlockGroup>> fusedGroups;
+    bool fixedPortSpecializations = true;
+    size_t blockCount = 0;
+    double blockCreationSeconds = 0.0;
+
+    static double SecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Blocks whose python class defines derivatives() get their states integrated by the host solver
+    template <typename T>
+    std::shared_ptr<PySysLinkBase::ISimulationBlock>
+    CreateInProcessBlock(const std::map<std::string, PySysLinkBase::ConfigurationValue>& blockConfiguration,
+                         std::shared_ptr<PySysLinkBase::IBlockEventsHandler> eventHandler,
+                         std::shared_ptr<IPythonExecutor> executor)
+    {
+        std::string moduleName = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("PythonModule", blockConfiguration);
+        std::string className = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("PythonClass", blockConfiguration);
+
+        bool continuousStates = false;
+        executor->Execute([&] {
+            PyObject* pyClass = classCache->GetClass(executor, moduleName, className);
+            continuousStates = PyObject_HasAttrString(pyClass, "derivatives");
+            Py_DECREF(pyClass);
+        });
+
+        if (continuousStates)
+        {
+            return std::make_shared<SimulationBlockPythonContinuous<T>>(blockConfiguration, eventHandler, executor, classCache, configurationCache);
+        }
+
+#ifdef BASIC_PYTHON_FIXED_PORT_SPECIALIZATIONS
+        if constexpr (!SignalTraits<T>::IsArray)
+        {
+            if (fixedPortSpecializations)
+            {
+                int numInputs = 1;
+                int numOutputs = 1;
+                try {
+                    numInputs = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<int>("InputPortNumber", blockConfiguration);
+                } catch (std::out_of_range&) {
+                    // default: 1
+                }
+                try {
+                    numOutputs = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<int>("OutputPortNumber", blockConfiguration);
+                } catch (std::out_of_range&) {
+                    // default: 1
+                }
+
+                // common small shapes: SISO, 2-in/1-out, and N-in/N-out up to 8
+                if (numInputs == 2 && numOutputs == 1) return CreateFixedPortBlock<T, 2, 1>(blockConfiguration, eventHandler, executor);
+                if (numInputs == numOutputs)
+                {
+                    switch (numInputs)
+                    {
+                        case 1: return CreateFixedPortBlock<T, 1, 1>(blockConfiguration, eventHandler, executor);
+                        case 2: return CreateFixedPortBlock<T, 2, 2>(blockConfiguration, eventHandler, executor);
+                        case 3: return CreateFixedPortBlock<T, 3, 3>(blockConfiguration, eventHandler, executor);
+                        case 4: return CreateFixedPortBlock<T, 4, 4>(blockConfiguration, eventHandler, executor);
+                        case 5: return CreateFixedPortBlock<T, 5, 5>(blockConfiguration, eventHandler, executor);
+                        case 6: return CreateFixedPortBlock<T, 6, 6>(blockConfiguration, eventHandler, executor);
+                        case 7: return CreateFixedPortBlock<T, 7, 7>(blockConfiguration, eventHandler, executor);
+                        case 8: return CreateFixedPortBlock<T, 8, 8>(blockConfiguration, eventHandler, executor);
+                        default: break;
+                    }
+                }
+            }
+        }
+#endif
+        return std::make_shared<SimulationBlockPython<T>>(blockConfiguration, eventHandler, executor, classCache, configurationCache);
+    }
+
+    std::shared_ptr<FusedBlockGroup> CreateFusedGroup(const std::string& name, std::shared_ptr<IPythonExecutor> executor)
+    {
+        auto group = std::make_shared<FusedBlockGroup>(name, executor);
+        fusedGroups.emplace(name, group);
+        return group;
+    }
+
+    // Blocks with continuous states compute from the solver's states and are never fused
+    void JoinFusedGroup(const std::shared_ptr<PySysLinkBase::ISimulationBlock>& block, const std::string& name, int index,
+                        const std::shared_ptr<FusedBlockGroup>& group)
+    {
+        auto member = std::dynamic_pointer_cast<IFusedPythonBlock>(block);
+        if (!member || std::dynamic_pointer_cast<PySysLinkBase::ISimulationBlockWithContinuousStates>(block))
+        {
+            spdlog::warn("FusionGroup {} ignored for a block with continuous states", name);
+            return;
+        }
+        group->Add(index, member);
+    }
+
+    template <typename T, int Inputs, int Outputs>
+    std::shared_ptr<PySysLinkBase::ISimulationBlock>
+    CreateFixedPortBlock(const std::map<std::string, PySysLinkBase::ConfigurationValue>& blockConfiguration,
+                         std::shared_ptr<PySysLinkBase::IBlockEventsHandler> eventHandler,
+                         std::shared_ptr<IPythonExecutor> executor)
+    {
+        return std::make_shared<SimulationBlockPython<T, PySysLinkBase::ISimulationBlock, Inputs, Outputs>>(blockConfiguration, eventHandler, executor, classCache, configurationCache);
+    }
+
+    std::shared_ptr<PySysLinkBase::ISimulationBlock>
+    CreateProcessBlock(std::map<std::string, PySysLinkBase::ConfigurationValue> blockConfiguration,
+                       std::shared_ptr<PySysLinkBase::IBlockEventsHandler> eventHandler,
+                       const std::string& signalType)
+    {
+        try
+        {
+            if (PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("PortExchange", blockConfiguration) != "List")
+            {
+                throw std::invalid_argument("ExecutionBackend Process only supports PortExchange List");
+            }
+        }
+        catch (std::out_of_range&)
+        {
+            // default: List
+        }
+
+        // worker processes are only started once a block asks for them
+        if (!processWorkerPool)
+        {
+            processWorkerPool = std::make_unique<ProcessWorkerPool>(pluginConfiguration, pythonModulePaths);
+        }
+
+        if (signalType == "Double")
+        {
+            return std::make_shared<SimulationBlockPythonProcess<double>>(blockConfiguration, eventHandler, processWorkerPool->NextWorker());
+        }
+        else if (signalType == "Complex")
+        {
+            return std::make_shared<SimulationBlockPythonProcess<std::complex<double>>>(blockConfiguration, eventHandler, processWorkerPool->NextWorker());
+        }
+        else
+        {
+            throw std::invalid_argument("Unsupported SignalType: " + signalType);
+        }
+    }
+
     void InitializePython(const std::map<std::string, PySysLinkBase::ConfigurationValue>& cfg)
     {
         PyConfig config;
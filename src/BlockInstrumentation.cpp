@@ -0,0 +1,269 @@
+#include "BlockInstrumentation.h"
+
+#include <fstream>
+
+#include <spdlog/spdlog.h>
+
+#include "LoggerInstance.h"
+#include "TextEscaping.h"
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+namespace
+{
+
+uint64_t BucketUpperNanoseconds(int bucket)
+{
+    return (uint64_t(1) << (bucket + 1)) - 1;
+}
+
+bool EndsWith(const std::string& value, const std::string& suffix)
+{
+    return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+std::shared_ptr<spdlog::logger> ReportLogger()
+{
+    auto logger = LoggerInstance::GetLogger();
+    return logger ? logger : spdlog::default_logger();
+}
+
+} // namespace
+
+const char* BridgePhaseName(BridgePhase phase)
+{
+    switch (phase)
+    {
+        case BridgePhase::GilAcquire: return "GilAcquire";
+        case BridgePhase::InputMarshalling: return "InputMarshalling";
+        case BridgePhase::Compute: return "Compute";
+        case BridgePhase::OutputUnmarshalling: return "OutputUnmarshalling";
+        case BridgePhase::Writeback: return "Writeback";
+        default: return "Unknown";
+    }
+}
+
+uint64_t LatencyHistogram::EstimateQuantileNanoseconds(double quantile) const
+{
+    uint64_t total = GetCount();
+    if (total == 0) return 0;
+
+    uint64_t target = static_cast<uint64_t>(quantile * static_cast<double>(total));
+    uint64_t seen = 0;
+    for (int i = 0; i < BucketCount; ++i)
+    {
+        seen += GetBucket(i);
+        if (seen > target)
+        {
+            return BucketUpperNanoseconds(i);
+        }
+    }
+    return GetMaxNanoseconds();
+}
+
+bool MemoryStatistics::Record(int64_t retainedBytes, uint64_t transientBytes, int64_t warningBytes)
+{
+    int64_t total = retained.load(std::memory_order_relaxed) + retainedBytes;
+    retained.store(total, std::memory_order_relaxed);
+    totalTransient.fetch_add(transientBytes, std::memory_order_relaxed);
+    if (transientBytes > maxTransient.load(std::memory_order_relaxed))
+    {
+        maxTransient.store(transientBytes, std::memory_order_relaxed);
+    }
+    uint64_t count = samples.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (count % WindowSamples != 0) return false;
+
+    // end of a window
+    growingWindows = total > windowStartRetained ? growingWindows + 1 : 0;
+    windowStartRetained = total;
+    bool growing = growingWindows >= GrowthWindows && total > warningBytes;
+    accumulating.store(growing, std::memory_order_relaxed);
+    if (!growing || (reportedRetained > 0 && total < 2 * reportedRetained)) return false;
+    reportedRetained = total;
+    return true;
+}
+
+void BlockInstrumentation::RecordMemory(int64_t retainedBytes, uint64_t transientBytes, int64_t warningBytes)
+{
+    if (memory.Record(retainedBytes, transientBytes, warningBytes))
+    {
+        ReportLogger()->warn("Python block {} keeps accumulating memory: {} bytes retained by {} sampled compute() calls",
+                             blockName, memory.GetRetainedBytes(), memory.GetSamples());
+    }
+}
+
+InstrumentationRegistry& InstrumentationRegistry::Instance()
+{
+    static InstrumentationRegistry instance;
+    return instance;
+}
+
+void InstrumentationRegistry::Enable(const std::string& reportPath)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    enabled = true;
+    this->reportPath = reportPath;
+}
+
+void InstrumentationRegistry::EnableMemoryTracking(uint32_t sampleInterval, int64_t warningBytes)
+{
+    memoryWarningBytes = warningBytes;
+    memorySampleInterval = sampleInterval > 0 ? sampleInterval : 1;
+}
+
+std::shared_ptr<BlockInstrumentation> InstrumentationRegistry::Register(const std::string& blockName)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!enabled) return nullptr;
+
+    auto block = std::make_shared<BlockInstrumentation>(blockName);
+    blocks.push_back(block);
+    return block;
+}
+
+std::vector<std::shared_ptr<BlockInstrumentation>> InstrumentationRegistry::GetBlocks() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return blocks;
+}
+
+void InstrumentationRegistry::Report() const
+{
+    if (!enabled) return;
+
+    auto logger = ReportLogger();
+    for (const auto& block : GetBlocks())
+    {
+        std::string line;
+        for (int p = 0; p < static_cast<int>(BridgePhase::Count); ++p)
+        {
+            const auto& histogram = block->GetPhase(static_cast<BridgePhase>(p));
+            uint64_t count = histogram.GetCount();
+            line += fmt::format(" {}={:.0f}ns", BridgePhaseName(static_cast<BridgePhase>(p)),
+                                count ? double(histogram.GetTotalNanoseconds()) / double(count) : 0.0);
+        }
+        logger->info("Python block {}: {} calls, {} memo hits, {} minor steps held, mean{}", block->GetBlockName(), block->GetCalls(),
+                     block->GetMemoHits(), block->GetMinorStepHolds(), line);
+
+        const MemoryStatistics& memory = block->GetMemory();
+        if (memory.GetSamples() > 0)
+        {
+            logger->info("Python block {}: {} calls sampled, {} bytes retained, {:.0f} bytes allocated per call on average, {} at most{}",
+                         block->GetBlockName(), memory.GetSamples(), memory.GetRetainedBytes(),
+                         double(memory.GetTotalTransientBytes()) / double(memory.GetSamples()), memory.GetMaxTransientBytes(),
+                         memory.IsAccumulating() ? ", still accumulating" : "");
+        }
+    }
+
+    if (reportPath.empty()) return;
+
+    if (EndsWith(reportPath, ".csv"))
+    {
+        WriteCsv(reportPath);
+    }
+    else
+    {
+        WriteJson(reportPath);
+    }
+    logger->info("Python block instrumentation report written to {}", reportPath);
+}
+
+void InstrumentationRegistry::WriteJson(const std::string& path) const
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        ReportLogger()->warn("Could not write instrumentation report to {}", path);
+        return;
+    }
+
+    out << "{\n  \"bucket_upper_ns\": [";
+    for (int i = 0; i < LatencyHistogram::BucketCount; ++i)
+    {
+        out << (i ? ", " : "") << BucketUpperNanoseconds(i);
+    }
+    out << "],\n  \"blocks\": [";
+
+    bool firstBlock = true;
+    for (const auto& block : GetBlocks())
+    {
+        out << (firstBlock ? "\n" : ",\n");
+        firstBlock = false;
+        out << "    {\"name\": ";
+        AppendJsonString(out, block->GetBlockName());
+        out << ", \"calls\": " << block->GetCalls()
+            << ", \"memo_hits\": " << block->GetMemoHits() << ", \"minor_step_holds\": " << block->GetMinorStepHolds() << ", \"phases\": {";
+        for (int p = 0; p < static_cast<int>(BridgePhase::Count); ++p)
+        {
+            const auto& histogram = block->GetPhase(static_cast<BridgePhase>(p));
+            out << (p ? ", " : "") << "\"" << BridgePhaseName(static_cast<BridgePhase>(p)) << "\": {"
+                << "\"count\": " << histogram.GetCount()
+                << ", \"total_ns\": " << histogram.GetTotalNanoseconds()
+                << ", \"max_ns\": " << histogram.GetMaxNanoseconds()
+                << ", \"buckets\": [";
+            for (int i = 0; i < LatencyHistogram::BucketCount; ++i)
+            {
+                out << (i ? ", " : "") << histogram.GetBucket(i);
+            }
+            out << "]}";
+        }
+        const MemoryStatistics& memory = block->GetMemory();
+        out << "}, \"memory\": {\"samples\": " << memory.GetSamples()
+            << ", \"retained_bytes\": " << memory.GetRetainedBytes()
+            << ", \"total_transient_bytes\": " << memory.GetTotalTransientBytes()
+            << ", \"max_transient_bytes\": " << memory.GetMaxTransientBytes()
+            << ", \"accumulating\": " << (memory.IsAccumulating() ? "true" : "false") << "}}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void InstrumentationRegistry::WriteCsv(const std::string& path) const
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        ReportLogger()->warn("Could not write instrumentation report to {}", path);
+        return;
+    }
+
+    out << "block,phase,count,total_ns,mean_ns,p50_ns,p99_ns,max_ns\n";
+    for (const auto& block : GetBlocks())
+    {
+        for (int p = 0; p < static_cast<int>(BridgePhase::Count); ++p)
+        {
+            const auto& histogram = block->GetPhase(static_cast<BridgePhase>(p));
+            uint64_t count = histogram.GetCount();
+            AppendCsvField(out, block->GetBlockName());
+            out << ',' << BridgePhaseName(static_cast<BridgePhase>(p)) << ','
+                << count << ',' << histogram.GetTotalNanoseconds() << ','
+                << (count ? histogram.GetTotalNanoseconds() / count : 0) << ','
+                << histogram.EstimateQuantileNanoseconds(0.5) << ','
+                << histogram.EstimateQuantileNanoseconds(0.99) << ','
+                << histogram.GetMaxNanoseconds() << '\n';
+        }
+    }
+
+    if (GetMemorySampleInterval() == 0) return;
+
+    std::string memoryPath = (EndsWith(path, ".csv") ? path.substr(0, path.size() - 4) : path) + ".memory.csv";
+    std::ofstream memoryOut(memoryPath);
+    if (!memoryOut)
+    {
+        ReportLogger()->warn("Could not write memory report to {}", memoryPath);
+        return;
+    }
+
+    memoryOut << "block,samples,retained_bytes,mean_transient_bytes,max_transient_bytes,accumulating\n";
+    for (const auto& block : GetBlocks())
+    {
+        const MemoryStatistics& memory = block->GetMemory();
+        uint64_t samples = memory.GetSamples();
+        AppendCsvField(memoryOut, block->GetBlockName());
+        memoryOut << ',' << samples << ',' << memory.GetRetainedBytes() << ','
+                  << (samples ? memory.GetTotalTransientBytes() / samples : 0) << ','
+                  << memory.GetMaxTransientBytes() << ',' << (memory.IsAccumulating() ? 1 : 0) << '\n';
+    }
+}
+
+} // namespace BlockTypeSupports::BasicPythonSupport
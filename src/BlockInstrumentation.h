@@ -0,0 +1,190 @@
+#ifndef SRC_BLOCK_INSTRUMENTATION_H
+#define SRC_BLOCK_INSTRUMENTATION_H
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+// Phases of one _ComputeOutputsOfBlock call, in execution order
+enum class BridgePhase : int
+{
+    GilAcquire = 0,          // waiting for the interpreter (GIL or sub-interpreter worker)
+    InputMarshalling = 1,    // reading input ports and converting them for python
+    Compute = 2,             // the python compute() call itself
+    OutputUnmarshalling = 3, // converting the python result back to T
+    Writeback = 4,           // storing the outputs in the output ports
+    Count = 5
+};
+
+const char* BridgePhaseName(BridgePhase phase);
+
+/*
+ * Fixed-bucket latency histogram. Bucket i counts samples in [2^i, 2^(i+1)) ns,
+ * the last bucket also holds everything above. Recording is a handful of relaxed
+ * atomic adds, so it can be read from other threads while the simulation runs.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr int BucketCount = 32;
+
+    void Record(uint64_t nanoseconds)
+    {
+        int bucket = nanoseconds == 0 ? 0 : 63 - __builtin_clzll(nanoseconds);
+        if (bucket >= BucketCount) bucket = BucketCount - 1;
+        buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+        uint64_t previousMax = maxNanoseconds.load(std::memory_order_relaxed);
+        while (nanoseconds > previousMax && !maxNanoseconds.compare_exchange_weak(previousMax, nanoseconds, std::memory_order_relaxed)) {}
+    }
+
+    uint64_t GetCount() const { return count.load(std::memory_order_relaxed); }
+    uint64_t GetTotalNanoseconds() const { return totalNanoseconds.load(std::memory_order_relaxed); }
+    uint64_t GetMaxNanoseconds() const { return maxNanoseconds.load(std::memory_order_relaxed); }
+    uint64_t GetBucket(int i) const { return buckets[i].load(std::memory_order_relaxed); }
+
+    // Upper bound of the bucket containing the given quantile (0..1)
+    uint64_t EstimateQuantileNanoseconds(double quantile) const;
+
+private:
+    std::array<std::atomic<uint64_t>, BucketCount> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> totalNanoseconds{0};
+    std::atomic<uint64_t> maxNanoseconds{0};
+};
+
+/*
+ * Python heap usage of a block's sampled compute() calls (see PythonMemoryProbe).
+ * Samples are grouped in windows of WindowSamples; a block whose retained bytes grew in
+ * GrowthWindows consecutive windows, and by more than the warning threshold in total, is accumulating.
+ * Written by the block's thread only, the totals can be read from any thread.
+ */
+class MemoryStatistics
+{
+public:
+    static constexpr uint64_t WindowSamples = 16;
+    static constexpr int GrowthWindows = 4;
+
+    // True when the block has to be reported as accumulating: the first time, and whenever
+    // its retained bytes doubled since the last report
+    bool Record(int64_t retainedBytes, uint64_t transientBytes, int64_t warningBytes);
+
+    uint64_t GetSamples() const { return samples.load(std::memory_order_relaxed); }
+    int64_t GetRetainedBytes() const { return retained.load(std::memory_order_relaxed); }
+    uint64_t GetTotalTransientBytes() const { return totalTransient.load(std::memory_order_relaxed); }
+    uint64_t GetMaxTransientBytes() const { return maxTransient.load(std::memory_order_relaxed); }
+    bool IsAccumulating() const { return accumulating.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> samples{0};
+    std::atomic<int64_t> retained{0};
+    std::atomic<uint64_t> totalTransient{0};
+    std::atomic<uint64_t> maxTransient{0};
+    std::atomic<bool> accumulating{false};
+
+    int64_t windowStartRetained = 0;
+    int growingWindows = 0;
+    int64_t reportedRetained = 0;
+};
+
+// Counters and per-phase histograms of one block
+class BlockInstrumentation
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit BlockInstrumentation(std::string blockName) : blockName(std::move(blockName)) {}
+
+    void Record(BridgePhase phase, Clock::time_point start, Clock::time_point end)
+    {
+        phases[static_cast<int>(phase)].Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+    }
+
+    void Record(BridgePhase phase, uint64_t nanoseconds)
+    {
+        phases[static_cast<int>(phase)].Record(nanoseconds);
+    }
+
+    void CountCall() { calls.fetch_add(1, std::memory_order_relaxed); }
+    // calls answered without python, see SimulationBlockPython memoization and MinorStepPolicy
+    void CountMemoHit() { memoHits.fetch_add(1, std::memory_order_relaxed); }
+    void CountMinorStepHold() { minorStepHolds.fetch_add(1, std::memory_order_relaxed); }
+
+    const std::string& GetBlockName() const { return blockName; }
+    uint64_t GetCalls() const { return calls.load(std::memory_order_relaxed); }
+    uint64_t GetMemoHits() const { return memoHits.load(std::memory_order_relaxed); }
+    uint64_t GetMinorStepHolds() const { return minorStepHolds.load(std::memory_order_relaxed); }
+    const LatencyHistogram& GetPhase(BridgePhase phase) const { return phases[static_cast<int>(phase)]; }
+
+    // One sampled call, warns through the plugin logger when the block keeps accumulating
+    void RecordMemory(int64_t retainedBytes, uint64_t transientBytes, int64_t warningBytes);
+    const MemoryStatistics& GetMemory() const { return memory; }
+
+private:
+    std::string blockName;
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> memoHits{0};
+    std::atomic<uint64_t> minorStepHolds{0};
+    std::array<LatencyHistogram, static_cast<int>(BridgePhase::Count)> phases;
+    MemoryStatistics memory;
+};
+
+/*
+ * Process-wide collection of block instrumentation, enabled from the plugin configuration:
+ *   BasicPythonSupport/instrumentation:       bool, default false
+ *   BasicPythonSupport/instrumentationReport: report file written at the end of the run,
+ *                                             CSV if it ends in .csv, JSON otherwise
+ *   BasicPythonSupport/memoryTracking:        bool, default false, python heap usage of every
+ *                                             memorySampleInterval-th compute() call (default 100);
+ *                                             implies instrumentation
+ *   BasicPythonSupport/memoryGrowthWarning:   retained bytes above which an accumulating block
+ *                                             is warned about, default 1 MiB
+ * The CSV report keeps the memory columns in a second file next to it, <name>.memory.csv.
+ * Records outlive their blocks so the end-of-run report covers every block of the run.
+ */
+class InstrumentationRegistry
+{
+public:
+    static InstrumentationRegistry& Instance();
+
+    void Enable(const std::string& reportPath);
+    bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    void EnableMemoryTracking(uint32_t sampleInterval, int64_t warningBytes);
+    // 0 while memory tracking is disabled
+    uint32_t GetMemorySampleInterval() const { return memorySampleInterval.load(std::memory_order_relaxed); }
+    int64_t GetMemoryWarningBytes() const { return memoryWarningBytes.load(std::memory_order_relaxed); }
+
+    // Returns nullptr while instrumentation is disabled
+    std::shared_ptr<BlockInstrumentation> Register(const std::string& blockName);
+
+    std::vector<std::shared_ptr<BlockInstrumentation>> GetBlocks() const;
+
+    // Summary through the plugin logger plus the configured report file, if any
+    void Report() const;
+    void WriteJson(const std::string& path) const;
+    void WriteCsv(const std::string& path) const;
+
+private:
+    std::atomic<bool> enabled{false};
+    std::atomic<uint32_t> memorySampleInterval{0};
+    std::atomic<int64_t> memoryWarningBytes{0};
+    std::string reportPath;
+    mutable std::mutex mutex;
+    std::vector<std::shared_ptr<BlockInstrumentation>> blocks;
+};
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_BLOCK_INSTRUMENTATION_H
@@ -0,0 +1,216 @@
+#include "BlockTrace.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+namespace
+{
+
+constexpr char TraceMagic[8] = {'P', 'S', 'L', 'T', 'R', 'A', 'C', 'E'};
+constexpr uint32_t TraceVersion = 1;
+constexpr size_t HeaderBytes = 64;
+// records looked ahead for a match when the next one differs
+constexpr uint64_t ResyncWindow = 64;
+
+struct TraceHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t elementSize;
+    char elementFormat[8];
+    uint32_t inputCount;
+    uint32_t outputCount;
+    uint64_t recordCount;
+};
+static_assert(sizeof(TraceHeader) <= HeaderBytes, "trace header does not fit");
+
+TraceHeader MakeHeader(const TraceLayout& layout)
+{
+    if (layout.elementFormat.size() >= sizeof(TraceHeader::elementFormat))
+    {
+        throw std::invalid_argument("BlockTrace: element format too long: " + layout.elementFormat);
+    }
+    TraceHeader header{};
+    std::memcpy(header.magic, TraceMagic, sizeof(TraceMagic));
+    header.version = TraceVersion;
+    header.elementSize = layout.elementSize;
+    std::memcpy(header.elementFormat, layout.elementFormat.data(), layout.elementFormat.size());
+    header.inputCount = layout.inputCount;
+    header.outputCount = layout.outputCount;
+    return header;
+}
+
+std::string SystemError()
+{
+    return std::string(std::strerror(errno));
+}
+
+} // namespace
+
+BlockTraceWriter::BlockTraceWriter(const std::string& path, const TraceLayout& layout)
+    : path(path), recordBytes(layout.RecordBytes()), inputBytes(static_cast<size_t>(layout.inputCount) * layout.elementSize)
+{
+    TraceHeader header = MakeHeader(layout);
+
+    fd = open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        throw std::runtime_error("BlockTraceWriter: could not open " + path + ": " + SystemError());
+    }
+    try {
+        Map(HeaderBytes + 1024 * recordBytes);
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+    std::memcpy(mapped, &header, sizeof(header));
+}
+
+BlockTraceWriter::~BlockTraceWriter()
+{
+    if (mapped)
+    {
+        munmap(mapped, mappedBytes);
+    }
+    if (fd >= 0)
+    {
+        // drop the unused capacity
+        if (ftruncate(fd, (off_t)(HeaderBytes + recordCount * recordBytes)) != 0)
+        {
+            spdlog::warn("BlockTraceWriter: could not truncate {}: {}", path, SystemError());
+        }
+        close(fd);
+    }
+    spdlog::info("Recorded {} steps to {}", recordCount, path);
+}
+
+void BlockTraceWriter::Map(size_t bytes)
+{
+    // the old mapping stays valid until the new one exists, so a failure leaves the writer usable
+    if (ftruncate(fd, (off_t)bytes) != 0)
+    {
+        throw std::runtime_error("BlockTraceWriter: could not grow " + path + ": " + SystemError());
+    }
+    void* address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED)
+    {
+        throw std::runtime_error("BlockTraceWriter: could not map " + path + ": " + SystemError());
+    }
+    if (mapped)
+    {
+        munmap(mapped, mappedBytes);
+    }
+    mapped = static_cast<unsigned char*>(address);
+    mappedBytes = bytes;
+}
+
+void BlockTraceWriter::Append(double time, const void* inputs, const void* outputs)
+{
+    size_t offset = HeaderBytes + recordCount * recordBytes;
+    if (offset + recordBytes > mappedBytes)
+    {
+        Map(HeaderBytes + 2 * (mappedBytes - HeaderBytes));
+    }
+
+    unsigned char* record = mapped + offset;
+    std::memcpy(record, &time, sizeof(double));
+    std::memcpy(record + sizeof(double), inputs, inputBytes);
+    std::memcpy(record + sizeof(double) + inputBytes, outputs, recordBytes - sizeof(double) - inputBytes);
+
+    ++recordCount;
+    std::memcpy(mapped + offsetof(TraceHeader, recordCount), &recordCount, sizeof(recordCount));
+}
+
+BlockTraceReader::BlockTraceReader(const std::string& path, const TraceLayout& layout)
+    : path(path), layout(layout), recordBytes(layout.RecordBytes())
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("BlockTraceReader: could not open " + path + ": " + SystemError());
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || (size_t)status.st_size < HeaderBytes)
+    {
+        close(fd);
+        throw std::runtime_error("BlockTraceReader: " + path + " is not a block trace");
+    }
+    mappedBytes = (size_t)status.st_size;
+    void* address = mmap(nullptr, mappedBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED)
+    {
+        throw std::runtime_error("BlockTraceReader: could not map " + path + ": " + SystemError());
+    }
+    mapped = static_cast<const unsigned char*>(address);
+
+    TraceHeader header;
+    std::memcpy(&header, mapped, sizeof(header));
+    TraceHeader expected = MakeHeader(layout);
+    if (std::memcmp(header.magic, TraceMagic, sizeof(TraceMagic)) != 0 || header.version != TraceVersion)
+    {
+        munmap(const_cast<unsigned char*>(mapped), mappedBytes);
+        throw std::runtime_error("BlockTraceReader: " + path + " is not a version " + std::to_string(TraceVersion) + " block trace");
+    }
+    if (header.elementSize != expected.elementSize || std::memcmp(header.elementFormat, expected.elementFormat, sizeof(header.elementFormat)) != 0 ||
+        header.inputCount != expected.inputCount || header.outputCount != expected.outputCount)
+    {
+        munmap(const_cast<unsigned char*>(mapped), mappedBytes);
+        throw std::runtime_error("BlockTraceReader: " + path + " was recorded with another signal type or port layout");
+    }
+
+    // a truncated file replays the complete records it holds
+    recordCount = std::min<uint64_t>(header.recordCount, (mappedBytes - HeaderBytes) / recordBytes);
+}
+
+BlockTraceReader::~BlockTraceReader()
+{
+    if (mapped)
+    {
+        munmap(const_cast<unsigned char*>(mapped), mappedBytes);
+    }
+    spdlog::info("Replayed {} of {} calls from {} ({} recorded steps)", hitCount, hitCount + missCount, path, recordCount);
+}
+
+bool BlockTraceReader::Matches(uint64_t record, double time, const void* inputs) const
+{
+    const unsigned char* data = mapped + HeaderBytes + record * recordBytes;
+    double recordedTime;
+    std::memcpy(&recordedTime, data, sizeof(double));
+    return recordedTime == time &&
+           std::memcmp(data + sizeof(double), inputs, static_cast<size_t>(layout.inputCount) * layout.elementSize) == 0;
+}
+
+bool BlockTraceReader::Next(double time, const void* inputs, void* outputs)
+{
+    uint64_t end = std::min(recordCount, cursor + ResyncWindow);
+    for (uint64_t record = cursor; record < end; ++record)
+    {
+        if (Matches(record, time, inputs))
+        {
+            const unsigned char* data = mapped + HeaderBytes + record * recordBytes;
+            size_t inputBytes = static_cast<size_t>(layout.inputCount) * layout.elementSize;
+            std::memcpy(outputs, data + sizeof(double) + inputBytes, static_cast<size_t>(layout.outputCount) * layout.elementSize);
+            cursor = record + 1;
+            ++hitCount;
+            return true;
+        }
+    }
+    ++missCount;
+    return false;
+}
+
+} // namespace BlockTypeSupports::BasicPythonSupport
@@ -0,0 +1,99 @@
+#ifndef SRC_BLOCK_TRACE_H
+#define SRC_BLOCK_TRACE_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+// What a block does with its I/O trace, block configuration TraceMode
+enum class TraceMode
+{
+    Off,
+    Record, // append (t, inputs, outputs) of every compute to TracePath
+    Replay  // serve outputs from TracePath while t and inputs match the recording
+};
+
+// Shape of one trace record, checked against the file header on replay
+struct TraceLayout
+{
+    std::string elementFormat; // struct format of one element, e.g. "d" or "Zd"
+    uint32_t elementSize = 0;
+    uint32_t inputCount = 0;   // elements, over all input ports
+    uint32_t outputCount = 0;  // elements, over all output ports
+
+    size_t RecordBytes() const
+    {
+        return sizeof(double) + static_cast<size_t>(inputCount + outputCount) * elementSize;
+    }
+};
+
+/*
+ * Binary trace file: a 64 byte header followed by packed records
+ *   double t | inputs[inputCount] | outputs[outputCount]
+ * in native byte order. The record count in the header is updated on every append,
+ * so a trace cut short by a crash still replays up to its last record.
+ */
+class BlockTraceWriter
+{
+public:
+    BlockTraceWriter(const std::string& path, const TraceLayout& layout);
+    ~BlockTraceWriter();
+
+    BlockTraceWriter(const BlockTraceWriter&) = delete;
+    BlockTraceWriter& operator=(const BlockTraceWriter&) = delete;
+
+    void Append(double time, const void* inputs, const void* outputs);
+
+    uint64_t GetRecordCount() const { return recordCount; }
+
+private:
+    std::string path;
+    size_t recordBytes;
+    size_t inputBytes;
+    int fd = -1;
+    unsigned char* mapped = nullptr;
+    size_t mappedBytes = 0;
+    uint64_t recordCount = 0;
+
+    void Map(size_t bytes);
+};
+
+class BlockTraceReader
+{
+public:
+    BlockTraceReader(const std::string& path, const TraceLayout& layout);
+    ~BlockTraceReader();
+
+    BlockTraceReader(const BlockTraceReader&) = delete;
+    BlockTraceReader& operator=(const BlockTraceReader&) = delete;
+
+    // Copies the recorded outputs if the next record (or one shortly after, to resync after
+    // a diverging call) has this t and these inputs, and advances past it. False otherwise.
+    bool Next(double time, const void* inputs, void* outputs);
+
+    uint64_t GetRecordCount() const { return recordCount; }
+    uint64_t GetHitCount() const { return hitCount; }
+    uint64_t GetMissCount() const { return missCount; }
+
+private:
+    std::string path;
+    TraceLayout layout;
+    size_t recordBytes;
+    const unsigned char* mapped = nullptr;
+    size_t mappedBytes = 0;
+    uint64_t recordCount = 0;
+    uint64_t cursor = 0;
+    uint64_t hitCount = 0;
+    uint64_t missCount = 0;
+
+    bool Matches(uint64_t record, double time, const void* inputs) const;
+};
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_BLOCK_TRACE_H
@@ -0,0 +1,783 @@
+#include "ConfigurationMapping.h"
+
+#include <algorithm>
+#include <complex>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "ConfigurationValueManager.h"
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+namespace
+{
+
+// Module holding the per-interpreter types and the arrays already wrapped in that interpreter
+constexpr const char* ModuleName = "_pysyslink_configuration";
+
+struct ConfigurationMappingObject
+{
+    PyObject_HEAD
+    std::shared_ptr<const InternedConfiguration>* configuration;
+    PyObject* converted; // key -> value already converted to python
+};
+
+struct ConfigurationArrayObject
+{
+    PyObject_HEAD
+    std::shared_ptr<const PySysLinkBase::ConfigurationValue>* owner;
+    const void* data;
+    Py_ssize_t length;
+    Py_ssize_t itemSize;
+    const char* format;
+};
+
+// ---- value hashing, for interning ----
+
+inline void HashCombine(size_t& seed, size_t value)
+{
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+template <typename S>
+size_t HashScalar(const S& value)
+{
+    if constexpr (std::is_same_v<S, std::complex<double>>)
+    {
+        size_t seed = std::hash<double>()(value.real());
+        HashCombine(seed, std::hash<double>()(value.imag()));
+        return seed;
+    }
+    else
+    {
+        return std::hash<S>()(value);
+    }
+}
+
+template <typename Variant>
+size_t HashVariant(const Variant& value)
+{
+    size_t seed = value.index();
+    std::visit([&seed](auto&& v) {
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<V, PySysLinkBase::ConfigurationValuePrimitive>)
+        {
+            HashCombine(seed, HashVariant(v));
+        }
+        else if constexpr (std::is_same_v<V, std::vector<PySysLinkBase::ConfigurationValuePrimitive>>)
+        {
+            for (const auto& element : v) HashCombine(seed, HashVariant(element));
+        }
+        else if constexpr (std::is_same_v<V, std::vector<bool>>)
+        {
+            for (bool element : v) HashCombine(seed, element ? 1 : 2);
+        }
+        else if constexpr (std::is_same_v<V, std::vector<int>> || std::is_same_v<V, std::vector<double>> ||
+                           std::is_same_v<V, std::vector<std::complex<double>>> || std::is_same_v<V, std::vector<std::string>>)
+        {
+            HashCombine(seed, v.size());
+            for (const auto& element : v) HashCombine(seed, HashScalar(element));
+        }
+        else
+        {
+            HashCombine(seed, HashScalar(v));
+        }
+    }, value);
+    return seed;
+}
+
+// ---- ConfigurationArray: read-only sequence over an interned vector ----
+
+// Numeric vector inside the value (possibly wrapped in a ConfigurationValuePrimitive), or false
+bool GetArrayStorage(const PySysLinkBase::ConfigurationValue& value, const void*& data, Py_ssize_t& length, Py_ssize_t& itemSize, const char*& format)
+{
+    static const double empty = 0.0;
+    bool found = false;
+    auto inspect = [&](auto&& v) {
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<V, std::vector<int>>)
+        {
+            data = v.data(); length = (Py_ssize_t)v.size(); itemSize = sizeof(int); format = "i"; found = true;
+        }
+        else if constexpr (std::is_same_v<V, std::vector<double>>)
+        {
+            data = v.data(); length = (Py_ssize_t)v.size(); itemSize = sizeof(double); format = "d"; found = true;
+        }
+        else if constexpr (std::is_same_v<V, std::vector<std::complex<double>>>)
+        {
+            data = v.data(); length = (Py_ssize_t)v.size(); itemSize = sizeof(std::complex<double>); format = "Zd"; found = true;
+        }
+    };
+    if (std::holds_alternative<PySysLinkBase::ConfigurationValuePrimitive>(value))
+    {
+        std::visit(inspect, std::get<PySysLinkBase::ConfigurationValuePrimitive>(value));
+    }
+    else
+    {
+        std::visit(inspect, value);
+    }
+    if (found && !data)
+    {
+        data = &empty;
+    }
+    return found;
+}
+
+PyObject* ArrayItem(ConfigurationArrayObject* self, Py_ssize_t i)
+{
+    if (!self->owner)
+    {
+        PyErr_SetString(PyExc_TypeError, "ConfigurationArray is not initialized");
+        return nullptr;
+    }
+    if (i < 0 || i >= self->length)
+    {
+        PyErr_SetString(PyExc_IndexError, "ConfigurationArray index out of range");
+        return nullptr;
+    }
+    switch (self->format[0])
+    {
+        case 'i': return PyLong_FromLong(static_cast<const int*>(self->data)[i]);
+        case 'd': return PyFloat_FromDouble(static_cast<const double*>(self->data)[i]);
+        default:
+        {
+            const auto& value = static_cast<const std::complex<double>*>(self->data)[i];
+            return PyComplex_FromDoubles(value.real(), value.imag());
+        }
+    }
+}
+
+PyObject* ArraySlice(ConfigurationArrayObject* self, Py_ssize_t start, Py_ssize_t step, Py_ssize_t count)
+{
+    PyObject* list = PyList_New(count);
+    if (!list) return nullptr;
+    for (Py_ssize_t j = 0; j < count; ++j)
+    {
+        PyObject* item = ArrayItem(self, start + j * step);
+        if (!item)
+        {
+            Py_DECREF(list);
+            return nullptr;
+        }
+        PyList_SET_ITEM(list, j, item);
+    }
+    return list;
+}
+
+Py_ssize_t ArrayLength(PyObject* self)
+{
+    return reinterpret_cast<ConfigurationArrayObject*>(self)->length;
+}
+
+PyObject* ArraySequenceItem(PyObject* self, Py_ssize_t i)
+{
+    return ArrayItem(reinterpret_cast<ConfigurationArrayObject*>(self), i);
+}
+
+PyObject* ArraySubscript(PyObject* self, PyObject* key)
+{
+    auto* array = reinterpret_cast<ConfigurationArrayObject*>(self);
+    if (PySlice_Check(key))
+    {
+        Py_ssize_t start, stop, step;
+        if (PySlice_Unpack(key, &start, &stop, &step) < 0) return nullptr;
+        Py_ssize_t count = PySlice_AdjustIndices(array->length, &start, &stop, step);
+        return ArraySlice(array, start, step, count);
+    }
+    Py_ssize_t i = PyNumber_AsSsize_t(key, PyExc_IndexError);
+    if (i == -1 && PyErr_Occurred()) return nullptr;
+    if (i < 0) i += array->length;
+    return ArrayItem(array, i);
+}
+
+PyObject* ArrayToList(PyObject* self, PyObject* /*unused*/)
+{
+    auto* array = reinterpret_cast<ConfigurationArrayObject*>(self);
+    return ArraySlice(array, 0, 1, array->length);
+}
+
+PyObject* ArrayRepr(PyObject* self)
+{
+    PyObject* list = ArrayToList(self, nullptr);
+    if (!list) return nullptr;
+    PyObject* repr = PyUnicode_FromFormat("ConfigurationArray(%R)", list);
+    Py_DECREF(list);
+    return repr;
+}
+
+int ArrayGetBuffer(PyObject* self, Py_buffer* view, int flags)
+{
+    auto* array = reinterpret_cast<ConfigurationArrayObject*>(self);
+    if (!array->owner)
+    {
+        PyErr_SetString(PyExc_BufferError, "ConfigurationArray is not initialized");
+        return -1;
+    }
+    if (flags & PyBUF_WRITABLE)
+    {
+        PyErr_SetString(PyExc_BufferError, "ConfigurationArray is read-only");
+        return -1;
+    }
+    view->obj = self;
+    Py_INCREF(self);
+    view->buf = const_cast<void*>(array->data);
+    view->len = array->length * array->itemSize;
+    view->readonly = 1;
+    view->itemsize = array->itemSize;
+    view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(array->format) : nullptr;
+    view->ndim = 1;
+    view->shape = (flags & PyBUF_ND) ? &array->length : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) ? &array->itemSize : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+void ArrayDealloc(PyObject* self)
+{
+    auto* array = reinterpret_cast<ConfigurationArrayObject*>(self);
+    delete array->owner;
+    PyTypeObject* type = Py_TYPE(self);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+// pickled as a plain list, e.g. when a block checkpoint stores an instance holding the configuration
+PyObject* ArrayReduce(PyObject* self, PyObject* /*unused*/)
+{
+    PyObject* list = ArrayToList(self, nullptr);
+    if (!list) return nullptr;
+    return Py_BuildValue("(O(N))", reinterpret_cast<PyObject*>(&PyList_Type), list);
+}
+
+PyMethodDef arrayMethods[] = {
+    {"tolist", ArrayToList, METH_NOARGS, "Copy of the values as a list"},
+    {"__reduce__", ArrayReduce, METH_NOARGS, "Pickled as a plain list"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+PyType_Slot arraySlots[] = {
+    {Py_tp_dealloc, reinterpret_cast<void*>(ArrayDealloc)},
+    {Py_tp_repr, reinterpret_cast<void*>(ArrayRepr)},
+    {Py_tp_methods, arrayMethods},
+    {Py_sq_length, reinterpret_cast<void*>(ArrayLength)},
+    {Py_sq_item, reinterpret_cast<void*>(ArraySequenceItem)},
+    {Py_mp_length, reinterpret_cast<void*>(ArrayLength)},
+    {Py_mp_subscript, reinterpret_cast<void*>(ArraySubscript)},
+#if PY_VERSION_HEX >= 0x03090000
+    {Py_bf_getbuffer, reinterpret_cast<void*>(ArrayGetBuffer)},
+#endif
+    {0, nullptr}
+};
+
+// ---- ConfigurationMapping: read-only mapping converting values on first access ----
+
+struct ModuleTypes
+{
+    PyObject* mappingType; // borrowed from the module
+    PyObject* arrayType;
+    PyObject* arrays;      // id of interned value -> ConfigurationArray
+};
+
+bool GetModuleTypes(ModuleTypes& types);
+
+ConfigurationMappingObject* AsMapping(PyObject* self)
+{
+    auto* mapping = reinterpret_cast<ConfigurationMappingObject*>(self);
+    if (!mapping->configuration)
+    {
+        PyErr_SetString(PyExc_TypeError, "ConfigurationMapping is not initialized");
+        return nullptr;
+    }
+    return mapping;
+}
+
+// New reference to the python form of an interned value; numeric vectors are shared per interpreter
+PyObject* ConvertValue(const std::shared_ptr<const PySysLinkBase::ConfigurationValue>& value)
+{
+    const void* data = nullptr;
+    Py_ssize_t length = 0, itemSize = 0;
+    const char* format = nullptr;
+    if (!GetArrayStorage(*value, data, length, itemSize, format))
+    {
+        return PySysLinkBase::ConfigurationValueToPyObject(*value);
+    }
+
+    ModuleTypes types;
+    if (!GetModuleTypes(types)) return nullptr;
+
+    PyObject* pyKey = PyLong_FromVoidPtr(const_cast<PySysLinkBase::ConfigurationValue*>(value.get()));
+    if (!pyKey) return nullptr;
+    PyObject* pyArray = PyDict_GetItemWithError(types.arrays, pyKey);
+    if (pyArray)
+    {
+        Py_DECREF(pyKey);
+        Py_INCREF(pyArray);
+        return pyArray;
+    }
+    if (PyErr_Occurred())
+    {
+        Py_DECREF(pyKey);
+        return nullptr;
+    }
+
+    pyArray = PyType_GenericAlloc(reinterpret_cast<PyTypeObject*>(types.arrayType), 0);
+    if (!pyArray)
+    {
+        Py_DECREF(pyKey);
+        return nullptr;
+    }
+    auto* array = reinterpret_cast<ConfigurationArrayObject*>(pyArray);
+    array->owner = new std::shared_ptr<const PySysLinkBase::ConfigurationValue>(value);
+    array->data = data;
+    array->length = length;
+    array->itemSize = itemSize;
+    array->format = format;
+
+    int stored = PyDict_SetItem(types.arrays, pyKey, pyArray);
+    Py_DECREF(pyKey);
+    if (stored < 0)
+    {
+        Py_DECREF(pyArray);
+        return nullptr;
+    }
+    return pyArray;
+}
+
+// New reference to mapping[key], KeyError (or nullptr with no error set if missing and !raise)
+PyObject* MappingLookup(ConfigurationMappingObject* mapping, PyObject* key, bool raise)
+{
+    PyObject* pyValue = PyDict_GetItemWithError(mapping->converted, key);
+    if (pyValue)
+    {
+        Py_INCREF(pyValue);
+        return pyValue;
+    }
+    if (PyErr_Occurred()) return nullptr;
+
+    const char* name = PyUnicode_Check(key) ? PyUnicode_AsUTF8(key) : nullptr;
+    if (!name)
+    {
+        PyErr_Clear();
+        if (raise) PyErr_SetObject(PyExc_KeyError, key);
+        return nullptr;
+    }
+    auto it = (*mapping->configuration)->find(name);
+    if (it == (*mapping->configuration)->end())
+    {
+        if (raise) PyErr_SetObject(PyExc_KeyError, key);
+        return nullptr;
+    }
+
+    pyValue = ConvertValue(it->second);
+    if (!pyValue) return nullptr;
+    // lists are mutable and the mapping is shared between blocks, so each access gets its own
+    if (PyList_Check(pyValue)) return pyValue;
+    if (PyDict_SetItem(mapping->converted, key, pyValue) < 0)
+    {
+        Py_DECREF(pyValue);
+        return nullptr;
+    }
+    return pyValue;
+}
+
+Py_ssize_t MappingLength(PyObject* self)
+{
+    auto* mapping = AsMapping(self);
+    return mapping ? (Py_ssize_t)(*mapping->configuration)->size() : -1;
+}
+
+PyObject* MappingSubscript(PyObject* self, PyObject* key)
+{
+    auto* mapping = AsMapping(self);
+    return mapping ? MappingLookup(mapping, key, true) : nullptr;
+}
+
+int MappingContains(PyObject* self, PyObject* key)
+{
+    auto* mapping = AsMapping(self);
+    if (!mapping) return -1;
+    const char* name = PyUnicode_Check(key) ? PyUnicode_AsUTF8(key) : nullptr;
+    if (!name)
+    {
+        PyErr_Clear();
+        return 0;
+    }
+    return (*mapping->configuration)->count(name) ? 1 : 0;
+}
+
+PyObject* MappingKeys(PyObject* self, PyObject* /*unused*/)
+{
+    auto* mapping = AsMapping(self);
+    if (!mapping) return nullptr;
+    PyObject* list = PyList_New((Py_ssize_t)(*mapping->configuration)->size());
+    if (!list) return nullptr;
+    Py_ssize_t i = 0;
+    for (const auto& kv : **mapping->configuration)
+    {
+        PyObject* pyKey = PyUnicode_FromString(kv.first.c_str());
+        if (!pyKey)
+        {
+            Py_DECREF(list);
+            return nullptr;
+        }
+        PyList_SET_ITEM(list, i++, pyKey);
+    }
+    return list;
+}
+
+// List of values (pairs = false) or (key, value) tuples, converting everything not converted yet
+PyObject* MappingEntries(PyObject* self, bool pairs)
+{
+    auto* mapping = AsMapping(self);
+    if (!mapping) return nullptr;
+    PyObject* keys = MappingKeys(self, nullptr);
+    if (!keys) return nullptr;
+    Py_ssize_t count = PyList_GET_SIZE(keys);
+    PyObject* list = PyList_New(count);
+    if (!list)
+    {
+        Py_DECREF(keys);
+        return nullptr;
+    }
+    for (Py_ssize_t i = 0; i < count; ++i)
+    {
+        PyObject* pyKey = PyList_GET_ITEM(keys, i);
+        PyObject* pyValue = MappingLookup(mapping, pyKey, true);
+        PyObject* entry = pyValue && pairs ? PyTuple_Pack(2, pyKey, pyValue) : pyValue;
+        if (pairs) Py_XDECREF(pyValue);
+        if (!entry)
+        {
+            Py_DECREF(list);
+            Py_DECREF(keys);
+            return nullptr;
+        }
+        PyList_SET_ITEM(list, i, entry);
+    }
+    Py_DECREF(keys);
+    return list;
+}
+
+PyObject* MappingValues(PyObject* self, PyObject* /*unused*/)
+{
+    return MappingEntries(self, false);
+}
+
+PyObject* MappingItems(PyObject* self, PyObject* /*unused*/)
+{
+    return MappingEntries(self, true);
+}
+
+PyObject* MappingGet(PyObject* self, PyObject* const* args, Py_ssize_t nargs)
+{
+    if (nargs < 1 || nargs > 2)
+    {
+        PyErr_SetString(PyExc_TypeError, "get() takes a key and an optional default");
+        return nullptr;
+    }
+    auto* mapping = AsMapping(self);
+    if (!mapping) return nullptr;
+    PyObject* pyValue = MappingLookup(mapping, args[0], false);
+    if (pyValue || PyErr_Occurred()) return pyValue;
+    PyObject* fallback = nargs == 2 ? args[1] : Py_None;
+    Py_INCREF(fallback);
+    return fallback;
+}
+
+// Plain dict with every value converted, for code that needs a mutable copy
+PyObject* MappingCopy(PyObject* self, PyObject* /*unused*/)
+{
+    PyObject* items = MappingItems(self, nullptr);
+    if (!items) return nullptr;
+    PyObject* dict = PyDict_New();
+    if (dict && PyDict_MergeFromSeq2(dict, items, 1) < 0)
+    {
+        Py_CLEAR(dict);
+    }
+    Py_DECREF(items);
+    return dict;
+}
+
+PyObject* MappingIter(PyObject* self)
+{
+    PyObject* keys = MappingKeys(self, nullptr);
+    if (!keys) return nullptr;
+    PyObject* iterator = PyObject_GetIter(keys);
+    Py_DECREF(keys);
+    return iterator;
+}
+
+PyObject* MappingRepr(PyObject* self)
+{
+    PyObject* dict = MappingCopy(self, nullptr);
+    if (!dict) return nullptr;
+    PyObject* repr = PyUnicode_FromFormat("ConfigurationMapping(%R)", dict);
+    Py_DECREF(dict);
+    return repr;
+}
+
+void MappingDealloc(PyObject* self)
+{
+    auto* mapping = reinterpret_cast<ConfigurationMappingObject*>(self);
+    delete mapping->configuration;
+    Py_XDECREF(mapping->converted);
+    PyTypeObject* type = Py_TYPE(self);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+// pickled as a plain dict
+PyObject* MappingReduce(PyObject* self, PyObject* /*unused*/)
+{
+    PyObject* dict = MappingCopy(self, nullptr);
+    if (!dict) return nullptr;
+    return Py_BuildValue("(O(N))", reinterpret_cast<PyObject*>(&PyDict_Type), dict);
+}
+
+PyMethodDef mappingMethods[] = {
+    {"get", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(MappingGet)), METH_FASTCALL, "Value for key, or the default"},
+    {"keys", MappingKeys, METH_NOARGS, "List of the configuration keys"},
+    {"values", MappingValues, METH_NOARGS, "List of the configuration values"},
+    {"items", MappingItems, METH_NOARGS, "List of (key, value) pairs"},
+    {"copy", MappingCopy, METH_NOARGS, "Configuration as a plain dict"},
+    {"__reduce__", MappingReduce, METH_NOARGS, "Pickled as a plain dict"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+PyType_Slot mappingSlots[] = {
+    {Py_tp_dealloc, reinterpret_cast<void*>(MappingDealloc)},
+    {Py_tp_repr, reinterpret_cast<void*>(MappingRepr)},
+    {Py_tp_iter, reinterpret_cast<void*>(MappingIter)},
+    {Py_tp_methods, mappingMethods},
+    {Py_mp_length, reinterpret_cast<void*>(MappingLength)},
+    {Py_mp_subscript, reinterpret_cast<void*>(MappingSubscript)},
+    {Py_sq_contains, reinterpret_cast<void*>(MappingContains)},
+    {0, nullptr}
+};
+
+#ifdef Py_TPFLAGS_DISALLOW_INSTANTIATION
+constexpr unsigned int TypeFlags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_DISALLOW_INSTANTIATION;
+#else
+constexpr unsigned int TypeFlags = Py_TPFLAGS_DEFAULT;
+#endif
+
+PyType_Spec mappingSpec = {
+    "_pysyslink_configuration.ConfigurationMapping", sizeof(ConfigurationMappingObject), 0, TypeFlags, mappingSlots
+};
+
+PyType_Spec arraySpec = {
+    "_pysyslink_configuration.ConfigurationArray", sizeof(ConfigurationArrayObject), 0, TypeFlags, arraySlots
+};
+
+// Types of the current interpreter, created on first use. Caller holds the GIL.
+bool GetModuleTypes(ModuleTypes& types)
+{
+    PyObject* module = PyImport_AddModule(ModuleName);
+    if (!module) return false;
+    PyObject* dict = PyModule_GetDict(module);
+
+    types.mappingType = PyDict_GetItemString(dict, "ConfigurationMapping");
+    types.arrayType = PyDict_GetItemString(dict, "ConfigurationArray");
+    types.arrays = PyDict_GetItemString(dict, "_arrays");
+    if (types.mappingType && types.arrayType && types.arrays)
+    {
+        return true;
+    }
+
+    PyObject* mappingType = PyType_FromSpec(&mappingSpec);
+    PyObject* arrayType = PyType_FromSpec(&arraySpec);
+    PyObject* arrays = PyDict_New();
+    bool ok = mappingType && arrayType && arrays &&
+              PyDict_SetItemString(dict, "ConfigurationMapping", mappingType) == 0 &&
+              PyDict_SetItemString(dict, "ConfigurationArray", arrayType) == 0 &&
+              PyDict_SetItemString(dict, "_arrays", arrays) == 0;
+#if PY_VERSION_HEX < 0x03090000
+    // no buffer slot for heap types before 3.9
+    if (ok)
+    {
+        static PyBufferProcs bufferProcs = {ArrayGetBuffer, nullptr};
+        reinterpret_cast<PyTypeObject*>(arrayType)->tp_as_buffer = &bufferProcs;
+    }
+#endif
+    Py_XDECREF(mappingType);
+    Py_XDECREF(arrayType);
+    Py_XDECREF(arrays);
+    if (!ok) return false;
+
+    // isinstance(config, collections.abc.Mapping)
+    PyObject* abc = PyImport_ImportModule("collections.abc");
+    PyObject* abcMapping = abc ? PyObject_GetAttrString(abc, "Mapping") : nullptr;
+    PyObject* result = abcMapping ? PyObject_CallMethod(abcMapping, "register", "O", mappingType) : nullptr;
+    Py_XDECREF(result);
+    Py_XDECREF(abcMapping);
+    Py_XDECREF(abc);
+    PyErr_Clear();
+
+    types.mappingType = PyDict_GetItemString(dict, "ConfigurationMapping");
+    types.arrayType = PyDict_GetItemString(dict, "ConfigurationArray");
+    types.arrays = PyDict_GetItemString(dict, "_arrays");
+    return true;
+}
+
+} // namespace
+
+bool IsBridgeConfigurationKey(const std::string& key)
+{
+    static const char* const bridgeKeys[] = {
+        "PythonModule", "PythonClass", "SignalType", "ExecutionBackend",
+        "InputPortNumber", "OutputPortNumber", "PortExchange", "SignalShape", "MinorStepPolicy",
+        "TraceMode", "TracePath", "TraceMismatch",
+        "Surrogate", "SurrogateRanges", "SurrogatePoints", "SurrogateCheckPoints", "SurrogateTolerance",
+        "FusionGroup", "FusionIndex"};
+    for (const char* bridgeKey : bridgeKeys)
+    {
+        if (key == bridgeKey) return true;
+    }
+    return false;
+}
+
+PyObject* NewConfigurationMapping(std::shared_ptr<const InternedConfiguration> configuration)
+{
+    ModuleTypes types;
+    if (!GetModuleTypes(types)) return nullptr;
+
+    PyObject* converted = PyDict_New();
+    if (!converted) return nullptr;
+    PyObject* pyMapping = PyType_GenericAlloc(reinterpret_cast<PyTypeObject*>(types.mappingType), 0);
+    if (!pyMapping)
+    {
+        Py_DECREF(converted);
+        return nullptr;
+    }
+    auto* mapping = reinterpret_cast<ConfigurationMappingObject*>(pyMapping);
+    mapping->configuration = new std::shared_ptr<const InternedConfiguration>(std::move(configuration));
+    mapping->converted = converted;
+    return pyMapping;
+}
+
+ConfigurationMappingCache::~ConfigurationMappingCache()
+{
+    std::vector<std::shared_ptr<IPythonExecutor>> executors;
+    for (auto& kv : mappings)
+    {
+        PyObject* object = kv.second.mapping;
+        kv.second.executor->Execute([object] { Py_DECREF(object); });
+        if (std::find(executors.begin(), executors.end(), kv.second.executor) == executors.end())
+        {
+            executors.push_back(kv.second.executor);
+        }
+    }
+
+    // arrays wrapped for this cache's values, keyed by their address: unused once the values are
+    // gone, and a later value at the same address must not find them
+    for (const auto& executor : executors)
+    {
+        executor->Execute([this] {
+            PyObject* module = PyImport_AddModule(ModuleName);
+            PyObject* arrays = module ? PyDict_GetItemString(PyModule_GetDict(module), "_arrays") : nullptr;
+            if (!arrays)
+            {
+                PyErr_Clear();
+                return;
+            }
+            for (const auto& kv : values)
+            {
+                PyObject* pyKey = PyLong_FromVoidPtr(const_cast<PySysLinkBase::ConfigurationValue*>(kv.second.get()));
+                if (pyKey && PyDict_DelItem(arrays, pyKey) < 0) PyErr_Clear(); // KeyError: never wrapped here
+                Py_XDECREF(pyKey);
+            }
+        });
+    }
+}
+
+std::shared_ptr<const PySysLinkBase::ConfigurationValue> ConfigurationMappingCache::InternValue(const PySysLinkBase::ConfigurationValue& value)
+{
+    size_t hash = HashVariant(value);
+    ++valueLookups;
+    auto range = values.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (*it->second == value)
+        {
+            return it->second;
+        }
+    }
+    auto interned = std::make_shared<const PySysLinkBase::ConfigurationValue>(value);
+    values.emplace(hash, interned);
+    return interned;
+}
+
+std::shared_ptr<const InternedConfiguration> ConfigurationMappingCache::Intern(const std::map<std::string, PySysLinkBase::ConfigurationValue>& configuration)
+{
+    InternedConfiguration interned;
+    size_t hash = configuration.size();
+    for (const auto& kv : configuration)
+    {
+        auto value = InternValue(kv.second);
+        HashCombine(hash, std::hash<std::string>()(kv.first));
+        HashCombine(hash, std::hash<const void*>()(value.get()));
+        interned.emplace(kv.first, std::move(value));
+    }
+
+    auto range = configurations.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (*it->second == interned)
+        {
+            return it->second;
+        }
+    }
+    auto shared = std::make_shared<const InternedConfiguration>(std::move(interned));
+    configurations.emplace(hash, shared);
+    return shared;
+}
+
+PyObject* ConfigurationMappingCache::GetMapping(const std::shared_ptr<IPythonExecutor>& executor,
+                                                const std::map<std::string, PySysLinkBase::ConfigurationValue>& configuration)
+{
+    std::shared_ptr<const InternedConfiguration> interned;
+    std::pair<IPythonExecutor*, const InternedConfiguration*> key;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        interned = Intern(configuration);
+        key = std::make_pair(executor.get(), interned.get());
+        ++mappingLookups;
+        auto it = mappings.find(key);
+        if (it != mappings.end())
+        {
+            Py_INCREF(it->second.mapping);
+            return it->second.mapping;
+        }
+    }
+
+    // create without holding the lock, creating the types may release the GIL
+    PyObject* pyMapping = NewConfigurationMapping(interned);
+    if (!pyMapping)
+    {
+        PyErr_Print();
+        throw std::runtime_error("ConfigurationMappingCache: Could not create the configuration mapping");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto inserted = mappings.emplace(key, Entry{executor, pyMapping});
+    if (!inserted.second)
+    {
+        Py_DECREF(pyMapping);
+    }
+    Py_INCREF(inserted.first->second.mapping);
+    return inserted.first->second.mapping;
+}
+
+void ConfigurationMappingCache::LogStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    spdlog::info("Configuration cache: {} values interned in {} lookups, {} mappings for {} configurations in {} lookups",
+                 values.size(), valueLookups, mappings.size(), configurations.size(), mappingLookups);
+}
+
+} // namespace BlockTypeSupports::BasicPythonSupport
@@ -0,0 +1,71 @@
+#ifndef SRC_CONFIGURATION_MAPPING_H
+#define SRC_CONFIGURATION_MAPPING_H
+
+#pragma once
+
+#include <Python.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <PySysLinkBase/ConfigurationValue.h>
+
+#include "PythonExecutor.h"
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+// Block configuration whose values are interned: identical values are one shared object
+using InternedConfiguration = std::map<std::string, std::shared_ptr<const PySysLinkBase::ConfigurationValue>>;
+
+// True for keys the bridge itself reads when the block is created (module and class, ports,
+// exchange, trace, surrogate, fusion): changing one needs a new block, not update_configuration()
+bool IsBridgeConfigurationKey(const std::string& key);
+
+// New reference to a read-only python mapping over the configuration, in the current interpreter.
+// Values are converted on first access and kept; int, double and complex vectors become
+// zero-copy read-only sequences that also export the buffer protocol (numpy.asarray wraps them).
+PyObject* NewConfigurationMapping(std::shared_ptr<const InternedConfiguration> configuration);
+
+/*
+ * Configuration mappings shared across blocks, so large lookup tables and coefficient arrays
+ * are stored once in C++, wrapped once per interpreter, and only boxed where python reads them.
+ * Identical block configurations share one mapping object per interpreter.
+ */
+class ConfigurationMappingCache
+{
+public:
+    ~ConfigurationMappingCache();
+
+    // New reference to the mapping for the configuration. Caller holds the executor's GIL.
+    PyObject* GetMapping(const std::shared_ptr<IPythonExecutor>& executor,
+                         const std::map<std::string, PySysLinkBase::ConfigurationValue>& configuration);
+
+    void LogStatistics() const;
+
+private:
+    std::shared_ptr<const InternedConfiguration> Intern(const std::map<std::string, PySysLinkBase::ConfigurationValue>& configuration);
+    std::shared_ptr<const PySysLinkBase::ConfigurationValue> InternValue(const PySysLinkBase::ConfigurationValue& value);
+
+    struct Entry
+    {
+        std::shared_ptr<IPythonExecutor> executor;
+        PyObject* mapping;
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_multimap<size_t, std::shared_ptr<const PySysLinkBase::ConfigurationValue>> values;
+    std::unordered_multimap<size_t, std::shared_ptr<const InternedConfiguration>> configurations;
+    std::map<std::pair<IPythonExecutor*, const InternedConfiguration*>, Entry> mappings;
+
+    unsigned long long valueLookups = 0;
+    unsigned long long mappingLookups = 0;
+};
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_CONFIGURATION_MAPPING_H
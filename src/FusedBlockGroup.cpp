@@ -0,0 +1,103 @@
+#include "FusedBlockGroup.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <spdlog/spdlog.h>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+FusedBlockGroup::FusedBlockGroup(std::string name, std::shared_ptr<IPythonExecutor> executor)
+    : name(std::move(name)), executor(std::move(executor))
+{
+}
+
+void FusedBlockGroup::Add(int index, const std::shared_ptr<IFusedPythonBlock>& member)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        members.emplace_back(index, member);
+        linked = false;
+    }
+    member->SetFusedGroup(shared_from_this());
+}
+
+void FusedBlockGroup::Remove(const IFusedPythonBlock* member)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    members.erase(std::remove_if(members.begin(), members.end(),
+                                 [member](const auto& entry) {
+                                     auto locked = entry.second.lock();
+                                     return !locked || locked.get() == member;
+                                 }),
+                  members.end());
+    chain.clear();
+    linked = false;
+}
+
+bool FusedBlockGroup::Evaluate(IFusedPythonBlock& member, double time, bool isMinorStep)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!linked) Link();
+    if (chain.empty() || chain.front() != &member)
+    {
+        return false;
+    }
+
+    executor->Execute([&] {
+        if (!member.FusedCompute(time, isMinorStep, nullptr)) return;
+        for (size_t k = 1; k < chain.size(); ++k)
+        {
+            if (!chain[k]->FusedCompute(time, isMinorStep, chain[k - 1]->GetFusedOutputs())) break;
+        }
+    });
+    ++evaluationCount;
+    return true;
+}
+
+size_t FusedBlockGroup::GetChainLength()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!linked) Link();
+    return chain.size();
+}
+
+void FusedBlockGroup::Link()
+{
+    // stable, so members sharing an index keep their creation order
+    std::stable_sort(members.begin(), members.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    chain.clear();
+    for (const auto& entry : members)
+    {
+        auto member = entry.second.lock();
+        if (!member) continue;
+        if (!chain.empty())
+        {
+            if (!member->CanComputeAhead())
+            {
+                spdlog::warn("FusedBlockGroup {}: member at FusionIndex {} does not declare pure, computing it ahead of "
+                             "the host would advance its state, the chain ends before it", name, entry.first);
+                break;
+            }
+            FusedPortLayout previous = chain.back()->GetFusedLayout();
+            FusedPortLayout next = member->GetFusedLayout();
+            if (previous.elementSize != next.elementSize || std::strcmp(previous.elementFormat, next.elementFormat) != 0 ||
+                previous.outputCount != next.inputCount)
+            {
+                spdlog::warn("FusedBlockGroup {}: member at FusionIndex {} does not take the outputs of the previous member "
+                             "({} x \"{}\" in, {} x \"{}\" out), the chain ends before it",
+                             name, entry.first, next.inputCount, next.elementFormat, previous.outputCount, previous.elementFormat);
+                break;
+            }
+        }
+        chain.push_back(member.get());
+    }
+    linked = true;
+    longestChain = std::max(longestChain, chain.size());
+    spdlog::debug("FusedBlockGroup {}: {} of {} members linked", name, chain.size(), members.size());
+}
+
+} // namespace BlockTypeSupports::BasicPythonSupport
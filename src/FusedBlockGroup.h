@@ -0,0 +1,107 @@
+#ifndef SRC_FUSED_BLOCK_GROUP_H
+#define SRC_FUSED_BLOCK_GROUP_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "PythonExecutor.h"
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+class FusedBlockGroup;
+
+// Flat port buffers of a group member, the outputs of one member feed the inputs of the next
+struct FusedPortLayout
+{
+    const char* elementFormat = ""; // struct format of one element, e.g. "d" or "Zd"
+    size_t elementSize = 0;
+    size_t inputCount = 0;          // elements, over all input ports
+    size_t outputCount = 0;         // elements, over all output ports
+};
+
+// Block side of a fused group, implemented by SimulationBlockPython
+class IFusedPythonBlock
+{
+public:
+    virtual ~IFusedPythonBlock() = default;
+
+    virtual FusedPortLayout GetFusedLayout() const = 0;
+
+    // True if an extra compute() ahead of the host cannot change the block's results, i.e. it declares pure.
+    // Only such blocks follow the head, since the chain computes them whether or not the host then asks.
+    virtual bool CanComputeAhead() const = 0;
+
+    // One compute from inputs, or from the block's own inputs when null (the head).
+    // Caller holds the GIL. False if the block does not compute on this call, which ends the chain.
+    virtual bool FusedCompute(double time, bool isMinorStep, const void* inputs) = 0;
+
+    // Flat outputs of the last FusedCompute()
+    virtual const void* GetFusedOutputs() const = 0;
+
+    virtual void SetFusedGroup(std::shared_ptr<FusedBlockGroup> group) = 0;
+};
+
+/*
+ * Chain of python blocks on one interpreter evaluated in a single C++ -> Python transition.
+ *
+ * Block configuration:
+ *   FusionGroup: group name, empty (default) for none
+ *   FusionIndex: position in the chain, member k reads the outputs of member k - 1 element for element
+ *
+ * When the host asks the head (lowest FusionIndex) for its outputs, the whole chain is computed
+ * under one GIL acquisition, each member fed the previous member's outputs. Each follower then
+ * answers its own host call from those outputs if t and the inputs on its ports match what it was
+ * fed, and computes as usual otherwise. Followers must declare pure: a follower that is not wired to
+ * the previous member, runs at another rate, or is called with other inputs is computed once more
+ * for nothing, which only a block without state can afford. Linking stops at the first follower
+ * that is not pure or whose layout does not continue the chain.
+ */
+class FusedBlockGroup : public std::enable_shared_from_this<FusedBlockGroup>
+{
+public:
+    FusedBlockGroup(std::string name, std::shared_ptr<IPythonExecutor> executor);
+
+    const std::string& GetName() const { return name; }
+
+    // Interpreter shared by every member
+    std::shared_ptr<IPythonExecutor> GetExecutor() const { return executor; }
+
+    void Add(int index, const std::shared_ptr<IFusedPythonBlock>& member);
+
+    // Called by a destroyed member, unlinks the chain
+    void Remove(const IFusedPythonBlock* member);
+
+    // Computes the chain if member is its head, false (nothing computed) otherwise
+    bool Evaluate(IFusedPythonBlock& member, double time, bool isMinorStep);
+
+    size_t GetChainLength();
+
+    // Most members ever linked at once, still known after the blocks are gone
+    size_t GetLongestChain() const { return longestChain; }
+
+    uint64_t GetEvaluationCount() const { return evaluationCount; }
+
+private:
+    std::string name;
+    std::shared_ptr<IPythonExecutor> executor;
+    std::vector<std::pair<int, std::weak_ptr<IFusedPythonBlock>>> members;
+    std::vector<IFusedPythonBlock*> chain; // linked members from the head on, valid while linked
+    bool linked = false;
+    size_t longestChain = 0;
+    uint64_t evaluationCount = 0;
+    std::mutex mutex;
+
+    void Link();
+};
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_FUSED_BLOCK_GROUP_H
@@ -0,0 +1,135 @@
+#include "LookupTableSurrogate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+LookupTableSurrogate::LookupTableSurrogate(size_t inputCount, size_t outputCount, const std::vector<double>& ranges, const std::vector<int>& points)
+    : inputCount(inputCount), outputCount(outputCount)
+{
+    if (inputCount == 0 || inputCount > MaxInputs)
+    {
+        throw std::invalid_argument("LookupTableSurrogate: supports 1 to " + std::to_string(MaxInputs) + " inputs, got " + std::to_string(inputCount));
+    }
+    if (ranges.size() != 2 * inputCount)
+    {
+        throw std::invalid_argument("LookupTableSurrogate: SurrogateRanges needs a low and a high value per input");
+    }
+    if (points.size() != 1 && points.size() != inputCount)
+    {
+        throw std::invalid_argument("LookupTableSurrogate: SurrogatePoints needs one value, or one per input");
+    }
+
+    for (size_t d = 0; d < inputCount; ++d)
+    {
+        double lo = ranges[2 * d];
+        double hi = ranges[2 * d + 1];
+        int n = points.size() == 1 ? points[0] : points[d];
+        if (!(lo < hi) || !std::isfinite(lo) || !std::isfinite(hi))
+        {
+            throw std::invalid_argument("LookupTableSurrogate: range of input " + std::to_string(d) + " is empty or not finite");
+        }
+        if (n < 2)
+        {
+            throw std::invalid_argument("LookupTableSurrogate: input " + std::to_string(d) + " needs at least 2 grid points");
+        }
+        low.push_back(lo);
+        high.push_back(hi);
+        this->points.push_back(static_cast<size_t>(n));
+        if (sampleCount > MaxSamples / static_cast<size_t>(n))
+        {
+            throw std::invalid_argument("LookupTableSurrogate: grid exceeds " + std::to_string(MaxSamples) + " points");
+        }
+        sampleCount *= static_cast<size_t>(n);
+    }
+
+    strides.assign(inputCount, 1);
+    for (size_t d = inputCount - 1; d > 0; --d)
+    {
+        strides[d - 1] = strides[d] * this->points[d];
+    }
+}
+
+void LookupTableSurrogate::Build(const SampleFunction& sample)
+{
+    table.assign(sampleCount * outputCount, 0.0);
+    std::vector<double> in(inputCount);
+    for (size_t s = 0; s < sampleCount; ++s)
+    {
+        for (size_t d = 0; d < inputCount; ++d)
+        {
+            size_t i = (s / strides[d]) % points[d];
+            in[d] = low[d] + (high[d] - low[d]) * static_cast<double>(i) / static_cast<double>(points[d] - 1);
+        }
+        sample(in.data(), table.data() + s * outputCount);
+    }
+}
+
+double LookupTableSurrogate::MaxError(const SampleFunction& sample, size_t count) const
+{
+    // fixed seed, so the check is reproducible
+    std::mt19937_64 generator(0x5eed);
+    std::vector<double> in(inputCount), expected(outputCount), interpolated(outputCount);
+    double maxError = 0.0;
+    for (size_t k = 0; k < count; ++k)
+    {
+        for (size_t d = 0; d < inputCount; ++d)
+        {
+            in[d] = std::uniform_real_distribution<double>(low[d], high[d])(generator);
+        }
+        sample(in.data(), expected.data());
+        Evaluate(in.data(), interpolated.data());
+        for (size_t o = 0; o < outputCount; ++o)
+        {
+            double error = std::abs(expected[o] - interpolated[o]);
+            // a NaN output is an infinite error
+            maxError = std::isnan(error) ? INFINITY : std::max(maxError, error);
+        }
+    }
+    return maxError;
+}
+
+bool LookupTableSurrogate::Evaluate(const double* in, double* out) const
+{
+    size_t cell[MaxInputs];
+    double fraction[MaxInputs];
+    for (size_t d = 0; d < inputCount; ++d)
+    {
+        if (!(in[d] >= low[d] && in[d] <= high[d]))
+        {
+            return false;
+        }
+        double position = (in[d] - low[d]) / (high[d] - low[d]) * static_cast<double>(points[d] - 1);
+        size_t i = std::min(static_cast<size_t>(position), points[d] - 2);
+        cell[d] = i;
+        fraction[d] = position - static_cast<double>(i);
+    }
+
+    std::fill(out, out + outputCount, 0.0);
+    // weighted sum over the 2^inputCount corners of the cell
+    for (size_t corner = 0; corner < (size_t(1) << inputCount); ++corner)
+    {
+        double weight = 1.0;
+        size_t offset = 0;
+        for (size_t d = 0; d < inputCount; ++d)
+        {
+            bool upper = (corner >> d) & 1;
+            weight *= upper ? fraction[d] : 1.0 - fraction[d];
+            offset += (cell[d] + (upper ? 1 : 0)) * strides[d];
+        }
+        if (weight == 0.0) continue;
+        const double* values = table.data() + offset * outputCount;
+        for (size_t o = 0; o < outputCount; ++o)
+        {
+            out[o] += weight * values[o];
+        }
+    }
+    return true;
+}
+
+} // namespace BlockTypeSupports::BasicPythonSupport
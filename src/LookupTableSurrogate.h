@@ -0,0 +1,54 @@
+#ifndef SRC_LOOKUP_TABLE_SURROGATE_H
+#define SRC_LOOKUP_TABLE_SURROGATE_H
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+/*
+ * Multilinear interpolation table standing in for a pure, time-independent compute().
+ * The table is sampled once on a uniform grid over the declared input ranges; inputs outside
+ * the ranges (or NaN) are not answered, so the caller falls back to the real compute().
+ */
+class LookupTableSurrogate
+{
+public:
+    // Fills in[] and expects out[] to be filled with the outputs for these inputs
+    using SampleFunction = std::function<void(const double* in, double* out)>;
+
+    static constexpr size_t MaxInputs = 4;
+    static constexpr size_t MaxSamples = size_t(1) << 20;
+
+    // ranges holds [low, high] per input, points the grid size per input (one value applies to all)
+    LookupTableSurrogate(size_t inputCount, size_t outputCount, const std::vector<double>& ranges, const std::vector<int>& points);
+
+    // Samples every grid point
+    void Build(const SampleFunction& sample);
+
+    // Largest absolute output error against sample() at count random in-range points
+    double MaxError(const SampleFunction& sample, size_t count) const;
+
+    // Interpolated outputs, false if an input is out of range
+    bool Evaluate(const double* in, double* out) const;
+
+    size_t GetSampleCount() const { return sampleCount; }
+
+private:
+    size_t inputCount;
+    size_t outputCount;
+    std::vector<double> low;
+    std::vector<double> high;
+    std::vector<size_t> points;
+    std::vector<size_t> strides; // in grid points, last input varies fastest
+    size_t sampleCount = 1;
+    std::vector<double> table;   // outputCount values per grid point
+};
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_LOOKUP_TABLE_SURROGATE_H
@@ -0,0 +1,117 @@
+#include "NativeKernel.h"
+
+#include <stdexcept>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+bool NativeKernel::Resolve(PyObject* pyInstance)
+{
+    if (!PyObject_HasAttrString(pyInstance, "native_kernel"))
+    {
+        return false;
+    }
+
+    PyObject* pyKernel = PyObject_GetAttrString(pyInstance, "native_kernel");
+    if (!pyKernel || pyKernel == Py_None)
+    {
+        Py_XDECREF(pyKernel);
+        PyErr_Clear();
+        return false;
+    }
+
+    std::string declared = "in_out_n_t";
+    if (PyObject_HasAttrString(pyInstance, "native_signature"))
+    {
+        PyObject* pySignature = PyObject_GetAttrString(pyInstance, "native_signature");
+        const char* value = pySignature && PyUnicode_Check(pySignature) ? PyUnicode_AsUTF8(pySignature) : nullptr;
+        declared = value ? value : "";
+        Py_XDECREF(pySignature);
+        PyErr_Clear();
+    }
+
+    if (declared == "in_out_n_t")
+    {
+        signature = NativeKernelSignature::InOutCountTime;
+    }
+    else if (declared == "in_nin_out_nout_t")
+    {
+        signature = NativeKernelSignature::InCountOutCountTime;
+    }
+    else
+    {
+        Py_DECREF(pyKernel);
+        throw std::invalid_argument("NativeKernel: Unsupported native_signature: " + declared);
+    }
+
+    void* resolved = AddressOf(pyKernel);
+    if (!resolved)
+    {
+        Py_DECREF(pyKernel);
+        throw std::invalid_argument("NativeKernel: native_kernel is not a function address, numba cfunc or ctypes function");
+    }
+
+    Release();
+    address = resolved;
+    pyOwner = pyKernel;
+    return true;
+}
+
+void NativeKernel::Release()
+{
+    Py_CLEAR(pyOwner);
+    address = nullptr;
+}
+
+void* NativeKernel::AddressOf(PyObject* pyKernel)
+{
+    // plain integer address
+    if (PyLong_Check(pyKernel))
+    {
+        void* result = PyLong_AsVoidPtr(pyKernel);
+        if (PyErr_Occurred())
+        {
+            PyErr_Clear();
+            return nullptr;
+        }
+        return result;
+    }
+
+    // numba cfunc
+    if (PyObject_HasAttrString(pyKernel, "address"))
+    {
+        PyObject* pyAddress = PyObject_GetAttrString(pyKernel, "address");
+        void* result = pyAddress && PyLong_Check(pyAddress) ? PyLong_AsVoidPtr(pyAddress) : nullptr;
+        Py_XDECREF(pyAddress);
+        PyErr_Clear();
+        return result;
+    }
+
+    // ctypes function pointer: ctypes.cast(kernel, ctypes.c_void_p).value,
+    // only for ctypes functions since cast() would also take e.g. the address of a str
+    void* result = nullptr;
+    PyObject* pyCtypes = PyImport_ImportModule("ctypes");
+    if (pyCtypes)
+    {
+        PyObject* pyFunctionType = PyObject_GetAttrString(pyCtypes, "_CFuncPtr");
+        if (pyFunctionType && PyObject_IsInstance(pyKernel, pyFunctionType) == 1)
+        {
+            PyObject* pyVoidPointer = PyObject_GetAttrString(pyCtypes, "c_void_p");
+            PyObject* pyCast = pyVoidPointer ? PyObject_CallMethod(pyCtypes, "cast", "OO", pyKernel, pyVoidPointer) : nullptr;
+            PyObject* pyValue = pyCast ? PyObject_GetAttrString(pyCast, "value") : nullptr;
+            if (pyValue && PyLong_Check(pyValue))
+            {
+                result = PyLong_AsVoidPtr(pyValue);
+            }
+            Py_XDECREF(pyValue);
+            Py_XDECREF(pyCast);
+            Py_XDECREF(pyVoidPointer);
+        }
+        Py_XDECREF(pyFunctionType);
+        Py_DECREF(pyCtypes);
+    }
+    PyErr_Clear();
+    return result;
+}
+
+} // namespace BlockTypeSupports::BasicPythonSupport
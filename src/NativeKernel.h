@@ -0,0 +1,68 @@
+#ifndef SRC_NATIVE_KERNEL_H
+#define SRC_NATIVE_KERNEL_H
+
+#pragma once
+
+#include <Python.h>
+
+#include <cstddef>
+#include <string>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+// C signatures a python block can declare for its native kernel, E being the port element type
+enum class NativeKernelSignature
+{
+    InOutCountTime,          // void(const E* in, E* out, size_t n, double t), as many inputs as outputs
+    InCountOutCountTime      // void(const E* in, size_t nIn, E* out, size_t nOut, double t)
+};
+
+/*
+ * Compiled function a python block hands over for its compute step:
+ *   class MyBlock:
+ *       native_kernel = my_cfunc                 # numba @cfunc, ctypes function or int address
+ *       native_signature = "in_out_n_t"          # default, or "in_nin_out_nout_t"
+ * cffi callbacks are passed as int(ffi.cast("uintptr_t", callback)).
+ *
+ * The kernel is called from C++ without the GIL, so it must not touch python objects.
+ * Complex signals pass double _Complex (std::complex<double>) elements.
+ */
+class NativeKernel
+{
+public:
+    // Reads native_kernel/native_signature from the instance. Caller holds the GIL.
+    // Returns false if the instance exposes no kernel, throws std::invalid_argument on an unusable declaration.
+    bool Resolve(PyObject* pyInstance);
+
+    // Drops the reference keeping the kernel alive. Caller holds the GIL.
+    void Release();
+
+    bool IsResolved() const { return address != nullptr; }
+    NativeKernelSignature GetSignature() const { return signature; }
+
+    template <typename E>
+    void Call(const E* in, size_t inputCount, E* out, size_t outputCount, double t) const
+    {
+        switch (signature)
+        {
+            case NativeKernelSignature::InOutCountTime:
+                reinterpret_cast<void (*)(const E*, E*, size_t, double)>(address)(in, out, inputCount, t);
+                break;
+            case NativeKernelSignature::InCountOutCountTime:
+                reinterpret_cast<void (*)(const E*, size_t, E*, size_t, double)>(address)(in, inputCount, out, outputCount, t);
+                break;
+        }
+    }
+
+private:
+    void* address = nullptr;
+    NativeKernelSignature signature = NativeKernelSignature::InOutCountTime;
+    PyObject* pyOwner = nullptr; // python object owning the code behind address
+
+    static void* AddressOf(PyObject* pyKernel);
+};
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_NATIVE_KERNEL_H
@@ -0,0 +1,114 @@
+#ifndef SRC_PORT_BUFFER_H
+#define SRC_PORT_BUFFER_H
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+// Port count only known at runtime
+constexpr int DynamicPortCount = -1;
+
+/*
+ * Contiguous element storage for all ports of one direction.
+ * With a fixed count the elements live inline in a std::array and size() is a compile-time
+ * constant, otherwise they are heap allocated once. Unlike std::vector<bool> it always has data().
+ */
+template <typename E, int FixedCount = DynamicPortCount>
+class PortBuffer
+{
+public:
+    static constexpr bool IsFixed = FixedCount != DynamicPortCount;
+
+    PortBuffer() = default;
+
+    PortBuffer(const PortBuffer& other)
+    {
+        *this = other;
+    }
+
+    PortBuffer& operator=(const PortBuffer& other)
+    {
+        if (this == &other) return *this;
+        if constexpr (IsFixed)
+        {
+            storage = other.storage;
+        }
+        else
+        {
+            Allocate(other.count);
+            std::copy(other.data(), other.data() + other.count, data());
+        }
+        return *this;
+    }
+
+    void assign(size_t n, E value)
+    {
+        if constexpr (IsFixed)
+        {
+            if (n != static_cast<size_t>(FixedCount))
+            {
+                throw std::invalid_argument("PortBuffer: size does not match the fixed port count");
+            }
+        }
+        else
+        {
+            Allocate(n);
+        }
+        std::fill(data(), data() + size(), value);
+    }
+
+    E* data()
+    {
+        if constexpr (IsFixed) return storage.data();
+        else return storage.get();
+    }
+
+    const E* data() const
+    {
+        if constexpr (IsFixed) return storage.data();
+        else return storage.get();
+    }
+
+    size_t size() const
+    {
+        if constexpr (IsFixed) return static_cast<size_t>(FixedCount);
+        else return count;
+    }
+
+    E& operator[](size_t i) { return data()[i]; }
+    const E& operator[](size_t i) const { return data()[i]; }
+
+    E* begin() { return data(); }
+    E* end() { return data() + size(); }
+    const E* begin() const { return data(); }
+    const E* end() const { return data() + size(); }
+
+private:
+    // std::array of at least one element, so zero fixed ports still have a valid data()
+    std::conditional_t<IsFixed, std::array<E, (FixedCount > 0 ? FixedCount : 1)>, std::unique_ptr<E[]>> storage{};
+    size_t count = 0;
+
+    void Allocate(size_t n)
+    {
+        if constexpr (!IsFixed)
+        {
+            if (n != count || !storage)
+            {
+                storage.reset(new E[n > 0 ? n : 1]);
+                count = n;
+            }
+        }
+    }
+};
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_PORT_BUFFER_H
@@ -0,0 +1,386 @@
+#include "ProcessWorkerPool.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+#include "TextEscaping.h"
+
+extern char** environ;
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+namespace
+{
+
+// python's json module accepts NaN and Infinity
+void AppendJson(std::ostringstream& out, double value)
+{
+    if (std::isnan(value)) out << "NaN";
+    else if (std::isinf(value)) out << (value > 0 ? "Infinity" : "-Infinity");
+    else out << value;
+}
+
+void AppendJson(std::ostringstream& out, int value) { out << value; }
+void AppendJson(std::ostringstream& out, bool value) { out << (value ? "true" : "false"); }
+void AppendJson(std::ostringstream& out, const std::string& value) { AppendJsonString(out, value); }
+
+void AppendJson(std::ostringstream& out, const std::complex<double>& value)
+{
+    out << "{\"__complex__\": [";
+    AppendJson(out, value.real());
+    out << ", ";
+    AppendJson(out, value.imag());
+    out << "]}";
+}
+
+template <typename... Ts>
+void AppendJson(std::ostringstream& out, const std::variant<Ts...>& value);
+
+template <typename E>
+void AppendJson(std::ostringstream& out, const std::vector<E>& values)
+{
+    out << '[';
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        if (i) out << ", ";
+        AppendJson(out, static_cast<const E&>(values[i]));
+    }
+    out << ']';
+}
+
+void AppendJson(std::ostringstream& out, const std::vector<bool>& values)
+{
+    out << '[';
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        if (i) out << ", ";
+        AppendJson(out, static_cast<bool>(values[i]));
+    }
+    out << ']';
+}
+
+template <typename... Ts>
+void AppendJson(std::ostringstream& out, const std::variant<Ts...>& value)
+{
+    std::visit([&out](auto&& v) { AppendJson(out, v); }, value);
+}
+
+template <typename T>
+T TryGetOrDefault(const std::map<std::string, PySysLinkBase::ConfigurationValue>& configuration, const std::string& key, T defaultValue)
+{
+    try {
+        return PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<T>(key, configuration);
+    } catch (std::out_of_range&) {
+        return defaultValue;
+    }
+}
+
+// directory of this shared library, the worker script is installed next to it
+std::string PluginDirectory()
+{
+    Dl_info info;
+    if (dladdr(reinterpret_cast<void*>(&PluginDirectory), &info) && info.dli_fname)
+    {
+        std::string path = info.dli_fname;
+        size_t slash = path.find_last_of('/');
+        if (slash != std::string::npos)
+        {
+            return path.substr(0, slash);
+        }
+    }
+    return ".";
+}
+
+} // namespace
+
+std::string ConfigurationToJson(const std::map<std::string, PySysLinkBase::ConfigurationValue>& configuration)
+{
+    std::ostringstream out;
+    out.precision(17);
+    out << '{';
+    bool first = true;
+    for (const auto& kv : configuration)
+    {
+        if (!first) out << ", ";
+        first = false;
+        AppendJsonString(out, kv.first);
+        out << ": ";
+        AppendJson(out, kv.second);
+    }
+    out << '}';
+    return out.str();
+}
+
+SharedMemoryRing::SharedMemoryRing(void* base, uint64_t capacity)
+{
+    header = new (base) SharedMemoryRingHeader();
+    header->head.store(0);
+    header->tail.store(0);
+    header->capacity = capacity;
+    header->reserved = 0;
+    data = static_cast<char*>(base) + sizeof(SharedMemoryRingHeader);
+}
+
+void SharedMemoryRing::Write(const void* source, uint64_t bytes)
+{
+    uint64_t head = header->head.load(std::memory_order_relaxed);
+    uint64_t tail = header->tail.load(std::memory_order_acquire);
+    if (header->capacity - (head - tail) < bytes)
+    {
+        throw std::runtime_error("SharedMemoryRing: message of " + std::to_string(bytes) + " bytes does not fit, increase BasicPythonSupport/processRingBytes");
+    }
+
+    uint64_t start = head % header->capacity;
+    uint64_t first = std::min(bytes, header->capacity - start);
+    std::memcpy(data + start, source, first);
+    std::memcpy(data, static_cast<const char*>(source) + first, bytes - first);
+    header->head.store(head + bytes, std::memory_order_release);
+}
+
+void SharedMemoryRing::Read(void* destination, uint64_t bytes)
+{
+    uint64_t tail = header->tail.load(std::memory_order_relaxed);
+    if (Available() < bytes)
+    {
+        throw std::runtime_error("SharedMemoryRing: truncated message");
+    }
+
+    uint64_t start = tail % header->capacity;
+    uint64_t first = std::min(bytes, header->capacity - start);
+    std::memcpy(destination, data + start, first);
+    std::memcpy(static_cast<char*>(destination) + first, data, bytes - first);
+    header->tail.store(tail + bytes, std::memory_order_release);
+}
+
+uint64_t SharedMemoryRing::Available() const
+{
+    return header->head.load(std::memory_order_acquire) - header->tail.load(std::memory_order_relaxed);
+}
+
+uint64_t SharedMemoryRing::Free() const
+{
+    return header->capacity - (header->head.load(std::memory_order_relaxed) - header->tail.load(std::memory_order_acquire));
+}
+
+ProcessWorker::ProcessWorker(const std::string& pythonExecutable, const std::string& workerScript,
+                             const std::vector<std::string>& modulePaths, uint64_t ringBytes)
+{
+    std::string sharedMemoryName = "/pysyslink_python_" + std::to_string(getpid()) + "_" + std::to_string(reinterpret_cast<uintptr_t>(this));
+    sharedMemoryFd = shm_open(sharedMemoryName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (sharedMemoryFd < 0)
+    {
+        throw std::runtime_error("ProcessWorker: shm_open failed: " + std::string(std::strerror(errno)));
+    }
+    // the worker inherits the descriptor, nothing is left behind in /dev/shm if either side crashes
+    shm_unlink(sharedMemoryName.c_str());
+
+    sharedMemoryBytes = 2 * (sizeof(SharedMemoryRingHeader) + ringBytes);
+    if (ftruncate(sharedMemoryFd, (off_t)sharedMemoryBytes) != 0)
+    {
+        close(sharedMemoryFd);
+        throw std::runtime_error("ProcessWorker: ftruncate failed: " + std::string(std::strerror(errno)));
+    }
+    sharedMemory = mmap(nullptr, sharedMemoryBytes, PROT_READ | PROT_WRITE, MAP_SHARED, sharedMemoryFd, 0);
+    if (sharedMemory == MAP_FAILED)
+    {
+        close(sharedMemoryFd);
+        throw std::runtime_error("ProcessWorker: mmap failed: " + std::string(std::strerror(errno)));
+    }
+    requestRing = SharedMemoryRing(sharedMemory, ringBytes);
+    responseRing = SharedMemoryRing(static_cast<char*>(sharedMemory) + sizeof(SharedMemoryRingHeader) + ringBytes, ringBytes);
+
+    // close-on-exec like the shm descriptor, so workers started later do not inherit them
+    requestEventFd = eventfd(0, EFD_CLOEXEC);
+    responseEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (requestEventFd < 0 || responseEventFd < 0)
+    {
+        munmap(sharedMemory, sharedMemoryBytes);
+        close(sharedMemoryFd);
+        throw std::runtime_error("ProcessWorker: eventfd failed: " + std::string(std::strerror(errno)));
+    }
+
+    std::ostringstream modulePathsJson;
+    modulePathsJson << '[';
+    for (size_t i = 0; i < modulePaths.size(); ++i)
+    {
+        if (i) modulePathsJson << ", ";
+        AppendJsonString(modulePathsJson, modulePaths[i]);
+    }
+    modulePathsJson << ']';
+
+    std::vector<std::string> arguments = {
+        pythonExecutable, workerScript,
+        std::to_string(sharedMemoryFd), std::to_string(sharedMemoryBytes), std::to_string(ringBytes),
+        std::to_string(requestEventFd), std::to_string(responseEventFd),
+        std::to_string(getpid()), modulePathsJson.str()
+    };
+    std::vector<char*> argv;
+    for (auto& argument : arguments) argv.push_back(const_cast<char*>(argument.c_str()));
+    argv.push_back(nullptr);
+
+    // only this worker's descriptors survive the exec: dup2 onto itself clears close-on-exec in the child
+    posix_spawn_file_actions_t fileActions;
+    posix_spawn_file_actions_init(&fileActions);
+    for (int fd : {sharedMemoryFd, requestEventFd, responseEventFd})
+    {
+        posix_spawn_file_actions_adddup2(&fileActions, fd, fd);
+    }
+    int spawnResult = posix_spawnp(&pid, pythonExecutable.c_str(), &fileActions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&fileActions);
+    if (spawnResult != 0)
+    {
+        close(requestEventFd);
+        close(responseEventFd);
+        munmap(sharedMemory, sharedMemoryBytes);
+        close(sharedMemoryFd);
+        throw std::runtime_error("ProcessWorker: Could not start " + pythonExecutable + ": " + std::strerror(spawnResult));
+    }
+    spdlog::info("Started Python worker process {} ({} {})", pid, pythonExecutable, workerScript);
+}
+
+ProcessWorker::~ProcessWorker()
+{
+    if (pid > 0)
+    {
+        std::vector<char> response;
+        try {
+            Call(WorkerMessageType::Shutdown, 0, 0.0, nullptr, 0, response);
+        } catch (std::exception& e) {
+            spdlog::warn("Python worker process {} did not shut down cleanly: {}", pid, e.what());
+            kill(pid, SIGKILL);
+        }
+        waitpid(pid, nullptr, 0);
+    }
+    close(requestEventFd);
+    close(responseEventFd);
+    munmap(sharedMemory, sharedMemoryBytes);
+    close(sharedMemoryFd);
+}
+
+void ProcessWorker::Call(WorkerMessageType type, uint32_t blockId, double time,
+                         const void* payload, uint64_t payloadBytes, std::vector<char>& response)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (pid <= 0)
+    {
+        throw std::runtime_error("ProcessWorker: worker process is not running");
+    }
+
+    WorkerMessageHeader header = { static_cast<uint32_t>(type), blockId, payloadBytes, time };
+    // checked as a whole, a header written without its payload would shift every later message
+    if (requestRing.Free() < sizeof(header) + payloadBytes)
+    {
+        throw std::runtime_error("ProcessWorker: request of " + std::to_string(sizeof(header) + payloadBytes) +
+                                 " bytes does not fit, increase BasicPythonSupport/processRingBytes");
+    }
+    requestRing.Write(&header, sizeof(header));
+    if (payloadBytes > 0)
+    {
+        requestRing.Write(payload, payloadBytes);
+    }
+    uint64_t signal = 1;
+    if (write(requestEventFd, &signal, sizeof(signal)) != sizeof(signal))
+    {
+        throw std::runtime_error("ProcessWorker: could not signal worker: " + std::string(std::strerror(errno)));
+    }
+
+    WaitForResponse();
+
+    WorkerMessageHeader reply;
+    responseRing.Read(&reply, sizeof(reply));
+    response.resize(reply.payloadBytes);
+    if (reply.payloadBytes > 0)
+    {
+        responseRing.Read(response.data(), reply.payloadBytes);
+    }
+
+    if (reply.type == static_cast<uint32_t>(WorkerMessageType::Error))
+    {
+        throw std::runtime_error("Python worker: " + std::string(response.begin(), response.end()));
+    }
+}
+
+uint32_t ProcessWorker::NextBlockId()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return nextBlockId++;
+}
+
+void ProcessWorker::WaitForResponse()
+{
+    while (true)
+    {
+        pollfd fd = { responseEventFd, POLLIN, 0 };
+        int ready = poll(&fd, 1, 100);
+        if (ready > 0)
+        {
+            uint64_t value;
+            if (read(responseEventFd, &value, sizeof(value)) == sizeof(value))
+            {
+                return;
+            }
+        }
+        else if (ready < 0 && errno != EINTR)
+        {
+            throw std::runtime_error("ProcessWorker: poll failed: " + std::string(std::strerror(errno)));
+        }
+
+        int status;
+        if (waitpid(pid, &status, WNOHANG) == pid)
+        {
+            pid = -1;
+            throw std::runtime_error("ProcessWorker: worker process exited unexpectedly");
+        }
+    }
+}
+
+ProcessWorkerPool::ProcessWorkerPool(const std::map<std::string, PySysLinkBase::ConfigurationValue>& pluginConfiguration,
+                                     const std::vector<std::string>& modulePaths)
+{
+    int count = TryGetOrDefault<int>(pluginConfiguration, "BasicPythonSupport/processWorkerCount", 1);
+    std::string venv = TryGetOrDefault<std::string>(pluginConfiguration, "BasicPythonSupport/venv", "");
+    std::string pythonExecutable = TryGetOrDefault<std::string>(pluginConfiguration, "BasicPythonSupport/pythonExecutable",
+                                                                venv.empty() ? "python3" : venv + "/bin/python");
+    std::string workerScript = TryGetOrDefault<std::string>(pluginConfiguration, "BasicPythonSupport/processWorkerScript",
+                                                            PluginDirectory() + "/pysyslink_python_worker.py");
+    int ringBytes = TryGetOrDefault<int>(pluginConfiguration, "BasicPythonSupport/processRingBytes", 1 << 20);
+
+    for (int i = 0; i < count; ++i)
+    {
+        workers.push_back(std::make_shared<ProcessWorker>(pythonExecutable, workerScript, modulePaths, (uint64_t)ringBytes));
+    }
+}
+
+std::shared_ptr<ProcessWorker> ProcessWorkerPool::NextWorker()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (workers.empty())
+    {
+        throw std::runtime_error("ProcessWorkerPool: no worker processes configured");
+    }
+    return workers[nextWorker++ % workers.size()];
+}
+
+} // namespace BlockTypeSupports::BasicPythonSupport
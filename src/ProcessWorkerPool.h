@@ -0,0 +1,138 @@
+#ifndef SRC_PROCESS_WORKER_POOL_H
+#define SRC_PROCESS_WORKER_POOL_H
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+#include <PySysLinkBase/ConfigurationValue.h>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+/*
+ * Message layout shared with pysyslink_python_worker.py. All fields little endian.
+ */
+enum class WorkerMessageType : uint32_t
+{
+    Create = 1,    // payload: JSON block configuration
+    Compute = 2,   // payload: NumInputs values of the block signal type
+    Destroy = 3,
+    Shutdown = 4,
+    UpdateConfiguration = 5, // payload: JSON object with the one updated entry, replies 1 (accepted) or 0
+    Ok = 16,       // payload: request dependent (outputs for Compute)
+    Error = 17     // payload: UTF-8 error message
+};
+
+struct WorkerMessageHeader
+{
+    uint32_t type;
+    uint32_t blockId;
+    uint64_t payloadBytes;
+    double time;
+};
+static_assert(sizeof(WorkerMessageHeader) == 24, "WorkerMessageHeader must match the worker script layout");
+
+/*
+ * Single producer, single consumer byte ring living in shared memory.
+ * head and tail are free-running byte counters; the eventfd syscalls that follow
+ * every write order the data with respect to the other process.
+ */
+struct SharedMemoryRingHeader
+{
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> tail;
+    uint64_t capacity;
+    uint64_t reserved;
+};
+static_assert(sizeof(SharedMemoryRingHeader) == 32, "SharedMemoryRingHeader must match the worker script layout");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared memory ring needs lock free 64 bit atomics");
+
+class SharedMemoryRing
+{
+public:
+    SharedMemoryRing() = default;
+    SharedMemoryRing(void* base, uint64_t capacity);
+
+    void Write(const void* data, uint64_t bytes);
+    void Read(void* data, uint64_t bytes);
+    uint64_t Available() const;
+    uint64_t Free() const;
+
+private:
+    SharedMemoryRingHeader* header = nullptr;
+    char* data = nullptr;
+};
+
+/*
+ * One local Python worker process hosting any number of block instances.
+ * Requests are synchronous: one outstanding call at a time per worker.
+ */
+class ProcessWorker
+{
+public:
+    ProcessWorker(const std::string& pythonExecutable, const std::string& workerScript,
+                  const std::vector<std::string>& modulePaths, uint64_t ringBytes);
+    ~ProcessWorker();
+
+    // Sends one request and waits for the reply, whose payload is left in response.
+    // Throws if the worker reports an error or has exited.
+    void Call(WorkerMessageType type, uint32_t blockId, double time,
+              const void* payload, uint64_t payloadBytes, std::vector<char>& response);
+
+    uint32_t NextBlockId();
+
+private:
+    void WaitForResponse();
+
+    pid_t pid = -1;
+    int sharedMemoryFd = -1;
+    int requestEventFd = -1;
+    int responseEventFd = -1;
+    void* sharedMemory = nullptr;
+    size_t sharedMemoryBytes = 0;
+    SharedMemoryRing requestRing;
+    SharedMemoryRing responseRing;
+
+    std::mutex mutex;
+    uint32_t nextBlockId = 1;
+};
+
+/*
+ * Pool of worker processes, blocks are assigned round robin.
+ *
+ * Plugin configuration:
+ *   BasicPythonSupport/processWorkerCount:  number of worker processes (default 1)
+ *   BasicPythonSupport/pythonExecutable:    interpreter used for the workers (default: venv python or python3)
+ *   BasicPythonSupport/processWorkerScript: worker script (default: installed next to the plugin)
+ *   BasicPythonSupport/processRingBytes:    capacity of each request/response ring (default 1 MiB)
+ */
+class ProcessWorkerPool
+{
+public:
+    ProcessWorkerPool(const std::map<std::string, PySysLinkBase::ConfigurationValue>& pluginConfiguration,
+                      const std::vector<std::string>& modulePaths);
+
+    std::shared_ptr<ProcessWorker> NextWorker();
+
+private:
+    std::vector<std::shared_ptr<ProcessWorker>> workers;
+    size_t nextWorker = 0;
+    std::mutex mutex;
+};
+
+// Serializes a block configuration as a JSON object, complex numbers become {"__complex__": [real, imag]}
+std::string ConfigurationToJson(const std::map<std::string, PySysLinkBase::ConfigurationValue>& configuration);
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_PROCESS_WORKER_POOL_H
@@ -0,0 +1,119 @@
+#include "PythonClassCache.h"
+
+#include <chrono>
+#include <stdexcept>
+
+#include <spdlog/spdlog.h>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+PythonClassCache::~PythonClassCache()
+{
+    for (auto& kv : classes)
+    {
+        PyObject* object = kv.second.object;
+        kv.second.executor->Execute([object] { Py_DECREF(object); });
+    }
+    for (auto& kv : modules)
+    {
+        PyObject* object = kv.second.object;
+        kv.second.executor->Execute([object] { Py_DECREF(object); });
+    }
+}
+
+PyObject* PythonClassCache::GetModule(const std::shared_ptr<IPythonExecutor>& executor, const std::string& moduleName)
+{
+    auto key = std::make_tuple(executor.get(), moduleName);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = modules.find(key);
+        if (it != modules.end())
+        {
+            Py_INCREF(it->second.object);
+            return it->second.object;
+        }
+    }
+
+    // import without holding the lock, importing may release the GIL
+    auto start = std::chrono::steady_clock::now();
+    PyObject* pyName = PyUnicode_FromString(moduleName.c_str());
+    PyObject* pyModule = PyImport_Import(pyName);
+    Py_DECREF(pyName);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (!pyModule)
+    {
+        PyErr_Print();
+        throw std::runtime_error("SimulationBlockPython: Could not import module: " + moduleName);
+    }
+    spdlog::info("Imported Python module {} in {:.1f} ms", moduleName, 1e3 * seconds);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    importSeconds += seconds;
+    auto inserted = modules.emplace(key, Entry{executor, pyModule});
+    if (!inserted.second)
+    {
+        // imported concurrently, keep the first entry
+        Py_DECREF(pyModule);
+    }
+    Py_INCREF(inserted.first->second.object);
+    return inserted.first->second.object;
+}
+
+PyObject* PythonClassCache::GetClass(const std::shared_ptr<IPythonExecutor>& executor, const std::string& moduleName, const std::string& className)
+{
+    auto key = std::make_tuple(executor.get(), moduleName, className);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++classLookups;
+        auto it = classes.find(key);
+        if (it != classes.end())
+        {
+            Py_INCREF(it->second.object);
+            return it->second.object;
+        }
+    }
+
+    PyObject* pyModule = GetModule(executor, moduleName);
+    PyObject* pyClass = PyObject_GetAttrString(pyModule, className.c_str());
+    Py_DECREF(pyModule);
+    if (!pyClass || !PyCallable_Check(pyClass))
+    {
+        Py_XDECREF(pyClass);
+        PyErr_Clear();
+        throw std::runtime_error("SimulationBlockPython: Class not found or not callable: " + className);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto inserted = classes.emplace(key, Entry{executor, pyClass});
+    if (!inserted.second)
+    {
+        Py_DECREF(pyClass);
+    }
+    Py_INCREF(inserted.first->second.object);
+    return inserted.first->second.object;
+}
+
+void PythonClassCache::Preload(const std::shared_ptr<IPythonExecutor>& executor, const std::vector<std::string>& moduleNames)
+{
+    executor->Execute([&] {
+        for (const auto& moduleName : moduleNames)
+        {
+            try {
+                Py_DECREF(GetModule(executor, moduleName));
+            } catch (std::runtime_error& e) {
+                spdlog::warn("Could not preload Python module {}: {}", moduleName, e.what());
+            }
+        }
+    });
+}
+
+void PythonClassCache::LogStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    spdlog::info("Python class cache: {} modules and {} classes resolved in {} lookups, {:.1f} ms importing",
+                 modules.size(), classes.size(), classLookups, 1e3 * importSeconds);
+}
+
+} // namespace BlockTypeSupports::BasicPythonSupport
@@ -0,0 +1,62 @@
+#ifndef SRC_PYTHON_CLASS_CACHE_H
+#define SRC_PYTHON_CLASS_CACHE_H
+
+#pragma once
+
+#include <Python.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "PythonExecutor.h"
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+/*
+ * Modules and classes resolved once per interpreter and shared by every block
+ * created from them, so model load time scales with the number of distinct
+ * (PythonModule, PythonClass) pairs instead of the number of blocks.
+ *
+ * Objects belong to the interpreter of the executor they were resolved with;
+ * entries are keyed by executor and released through it.
+ */
+class PythonClassCache
+{
+public:
+    ~PythonClassCache();
+
+    // New reference to moduleName.className. Caller holds the executor's GIL.
+    // Throws std::runtime_error if the module cannot be imported or the class is missing.
+    PyObject* GetClass(const std::shared_ptr<IPythonExecutor>& executor, const std::string& moduleName, const std::string& className);
+
+    // Imports the modules up front in the executor's interpreter, failures are logged and skipped
+    void Preload(const std::shared_ptr<IPythonExecutor>& executor, const std::vector<std::string>& moduleNames);
+
+    void LogStatistics() const;
+
+private:
+    // New reference to the module. Caller holds the executor's GIL.
+    PyObject* GetModule(const std::shared_ptr<IPythonExecutor>& executor, const std::string& moduleName);
+
+    struct Entry
+    {
+        std::shared_ptr<IPythonExecutor> executor;
+        PyObject* object;
+    };
+
+    mutable std::mutex mutex;
+    std::map<std::tuple<IPythonExecutor*, std::string>, Entry> modules;
+    std::map<std::tuple<IPythonExecutor*, std::string, std::string>, Entry> classes;
+
+    unsigned long long classLookups = 0;
+    double importSeconds = 0.0;
+};
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_PYTHON_CLASS_CACHE_H
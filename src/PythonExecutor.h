@@ -0,0 +1,68 @@
+#ifndef SRC_PYTHON_EXECUTOR_H
+#define SRC_PYTHON_EXECUTOR_H
+
+#pragma once
+
+#include <Python.h>
+
+#include <memory>
+#include <type_traits>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+/*
+ * Runs code against one Python interpreter with its GIL held.
+ *
+ * Blocks never acquire the GIL themselves: everything that touches Python goes
+ * through the executor they were created with, so the same block code can run
+ * on the main interpreter or on a sub-interpreter pinned to a worker thread.
+ */
+class IPythonExecutor
+{
+public:
+    virtual ~IPythonExecutor() = default;
+
+    // Calls fn(context) with the interpreter's GIL held, on whichever thread owns the interpreter.
+    // Blocks until fn returns; exceptions thrown by fn propagate to the caller.
+    virtual void Run(void (*fn)(void*), void* context) = 0;
+
+    // Convenience wrapper for lambdas, does not allocate
+    template <typename F>
+    void Execute(F&& f)
+    {
+        using Callable = std::remove_reference_t<F>;
+        Run([](void* context) { (*static_cast<Callable*>(context))(); },
+            const_cast<void*>(static_cast<const void*>(&f)));
+    }
+};
+
+// Main interpreter, shared GIL acquired on the calling thread
+class MainInterpreterExecutor : public IPythonExecutor
+{
+public:
+    void Run(void (*fn)(void*), void* context) override
+    {
+        PyGILState_STATE gstate = PyGILState_Ensure();
+        try
+        {
+            fn(context);
+        }
+        catch (...)
+        {
+            PyGILState_Release(gstate);
+            throw;
+        }
+        PyGILState_Release(gstate);
+    }
+
+    static std::shared_ptr<IPythonExecutor> Instance()
+    {
+        static std::shared_ptr<IPythonExecutor> instance = std::make_shared<MainInterpreterExecutor>();
+        return instance;
+    }
+};
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_PYTHON_EXECUTOR_H
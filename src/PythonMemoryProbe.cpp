@@ -0,0 +1,106 @@
+#include "PythonMemoryProbe.h"
+
+#include <spdlog/spdlog.h>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+bool PythonMemoryProbe::Resolve()
+{
+    PyObject* pyTracemalloc = PyImport_ImportModule("tracemalloc");
+    if (!pyTracemalloc)
+    {
+        PyErr_Clear();
+        spdlog::warn("PythonMemoryProbe: tracemalloc is not available, python memory is not tracked");
+        return false;
+    }
+
+    PyObject* pyTracing = PyObject_CallMethod(pyTracemalloc, "is_tracing", nullptr);
+    bool tracing = pyTracing && PyObject_IsTrue(pyTracing) == 1;
+    Py_XDECREF(pyTracing);
+    if (!tracing)
+    {
+        PyObject* pyStarted = PyObject_CallMethod(pyTracemalloc, "start", nullptr);
+        if (!pyStarted)
+        {
+            PyErr_Clear();
+            Py_DECREF(pyTracemalloc);
+            spdlog::warn("PythonMemoryProbe: tracemalloc.start() failed, python memory is not tracked");
+            return false;
+        }
+        Py_DECREF(pyStarted);
+    }
+
+    pyGetTracedMemory = PyObject_GetAttrString(pyTracemalloc, "get_traced_memory");
+    pyResetPeak = PyObject_GetAttrString(pyTracemalloc, "reset_peak");
+    if (!pyResetPeak)
+    {
+        PyErr_Clear();
+    }
+    Py_DECREF(pyTracemalloc);
+    if (!pyGetTracedMemory)
+    {
+        PyErr_Clear();
+        Py_CLEAR(pyResetPeak);
+        return false;
+    }
+    return true;
+}
+
+void PythonMemoryProbe::Release()
+{
+    Py_CLEAR(pyGetTracedMemory);
+    Py_CLEAR(pyResetPeak);
+}
+
+void PythonMemoryProbe::Begin()
+{
+    if (pyResetPeak)
+    {
+        PyObject* pyResult = PyObject_CallObject(pyResetPeak, nullptr);
+        if (pyResult) Py_DECREF(pyResult);
+        else PyErr_Clear();
+    }
+    uint64_t peak = 0;
+    if (!TracedMemory(startBytes, peak))
+    {
+        startBytes = 0;
+    }
+}
+
+MemorySample PythonMemoryProbe::End() const
+{
+    MemorySample sample;
+    uint64_t current = 0;
+    uint64_t peak = 0;
+    if (!startBytes || !TracedMemory(current, peak))
+    {
+        return sample;
+    }
+    sample.retainedBytes = static_cast<int64_t>(current) - static_cast<int64_t>(startBytes);
+    sample.transientBytes = peak > startBytes ? peak - startBytes : 0;
+    return sample;
+}
+
+bool PythonMemoryProbe::TracedMemory(uint64_t& current, uint64_t& peak) const
+{
+    // the result tuple is allocated after the counters are read, so it is not part of them
+    PyObject* pyResult = PyObject_CallObject(pyGetTracedMemory, nullptr);
+    if (!pyResult || !PyTuple_Check(pyResult) || PyTuple_GET_SIZE(pyResult) != 2)
+    {
+        Py_XDECREF(pyResult);
+        PyErr_Clear();
+        return false;
+    }
+    current = PyLong_AsUnsignedLongLong(PyTuple_GET_ITEM(pyResult, 0));
+    peak = PyLong_AsUnsignedLongLong(PyTuple_GET_ITEM(pyResult, 1));
+    Py_DECREF(pyResult);
+    if (PyErr_Occurred())
+    {
+        PyErr_Clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace BlockTypeSupports::BasicPythonSupport
@@ -0,0 +1,56 @@
+#ifndef SRC_PYTHON_MEMORY_PROBE_H
+#define SRC_PYTHON_MEMORY_PROBE_H
+
+#pragma once
+
+#include <Python.h>
+
+#include <cstdint>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+// Python heap usage of one call, as seen by tracemalloc
+struct MemorySample
+{
+    int64_t retainedBytes = 0;   // still allocated when the call returned, negative if it freed more than it allocated
+    uint64_t transientBytes = 0; // peak above the usage at the start of the call
+};
+
+/*
+ * Measures the python heap around a call with tracemalloc.
+ * tracemalloc traces every allocation of the interpreter, not only those of one block, so the
+ * measurement is only attributable while the caller holds the GIL for the whole call; its peak is
+ * reset at every Begin(). Tracing slows down all python code of the interpreter while it runs.
+ * Its counters and peak are shared by every interpreter of the process, and sub-interpreters with
+ * their own GIL allocate and reset the peak concurrently, so BlockFactoryPython does not enable
+ * memory tracking together with the sub-interpreter backend.
+ */
+class PythonMemoryProbe
+{
+public:
+    // Starts tracemalloc if it is not tracing yet. Caller holds the GIL.
+    // Returns false (with a warning) if tracemalloc is unavailable.
+    bool Resolve();
+
+    // Drops the references to tracemalloc. Caller holds the GIL.
+    void Release();
+
+    bool IsResolved() const { return pyGetTracedMemory != nullptr; }
+
+    // Around the measured call, caller holds the GIL throughout
+    void Begin();
+    MemorySample End() const;
+
+private:
+    PyObject* pyGetTracedMemory = nullptr;
+    PyObject* pyResetPeak = nullptr; // null before Python 3.9, transient bytes are then a lower bound
+    uint64_t startBytes = 0;
+
+    // (current, peak) of tracemalloc.get_traced_memory(), false on failure
+    bool TracedMemory(uint64_t& current, uint64_t& peak) const;
+};
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_PYTHON_MEMORY_PROBE_H
@@ -2,7 +2,12 @@
 #include "BlockFactoryPython.h"
 #include "spdlog/spdlog.h"
 #include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
 #include "LoggerInstance.h"
+#include "BlockInstrumentation.h"
+#include "BlockCheckpoint.h"
 
 extern "C" void RegisterBlockFactories(std::map<std::string, std::shared_ptr<PySysLinkBase::IBlockFactory>>& registry, std::map<std::string, PySysLinkBase::ConfigurationValue> pluginConfiguration) {
     std::cout << "Call to RegisterBlockFactories" << std::endl;
@@ -14,3 +19,88 @@ extern "C" void RegisterSpdlogLogger(std::shared_ptr<spdlog::logger> logger) {
     BlockTypeSupports::BasicPythonSupport::LoggerInstance::SetLogger(logger);
     BlockTypeSupports::BasicPythonSupport::LoggerInstance::GetLogger()->debug("Logger from plugin BlockTypeSupportsBasicPython!");
 }
+
+// Instrumentation queries, usable while the simulation runs
+
+extern "C" int BasicPythonSupportInstrumentationBlockCount() {
+    return (int)BlockTypeSupports::BasicPythonSupport::InstrumentationRegistry::Instance().GetBlocks().size();
+}
+
+// Copies the block name into buffer, returns its full length or -1 if the index is out of range
+extern "C" int BasicPythonSupportInstrumentationBlockName(int blockIndex, char* buffer, int bufferSize) {
+    auto blocks = BlockTypeSupports::BasicPythonSupport::InstrumentationRegistry::Instance().GetBlocks();
+    if (blockIndex < 0 || blockIndex >= (int)blocks.size()) return -1;
+    const std::string& name = blocks[blockIndex]->GetBlockName();
+    if (buffer && bufferSize > 0) {
+        size_t n = std::min(name.size(), (size_t)bufferSize - 1);
+        std::memcpy(buffer, name.data(), n);
+        buffer[n] = '\0';
+    }
+    return (int)name.size();
+}
+
+// phase: 0 GilAcquire, 1 InputMarshalling, 2 Compute, 3 OutputUnmarshalling, 4 Writeback.
+// buckets receives up to bucketCount histogram buckets (bucket i covers [2^i, 2^(i+1)) ns), may be null.
+// Returns 0 on success, -1 on an invalid index.
+extern "C" int BasicPythonSupportInstrumentationPhase(int blockIndex, int phase, uint64_t* count, uint64_t* totalNanoseconds,
+                                                     uint64_t* maxNanoseconds, uint64_t* buckets, int bucketCount) {
+    using namespace BlockTypeSupports::BasicPythonSupport;
+    auto blocks = InstrumentationRegistry::Instance().GetBlocks();
+    if (blockIndex < 0 || blockIndex >= (int)blocks.size() || phase < 0 || phase >= (int)BridgePhase::Count) return -1;
+    const LatencyHistogram& histogram = blocks[blockIndex]->GetPhase(static_cast<BridgePhase>(phase));
+    if (count) *count = histogram.GetCount();
+    if (totalNanoseconds) *totalNanoseconds = histogram.GetTotalNanoseconds();
+    if (maxNanoseconds) *maxNanoseconds = histogram.GetMaxNanoseconds();
+    for (int i = 0; buckets && i < bucketCount && i < LatencyHistogram::BucketCount; ++i) {
+        buckets[i] = histogram.GetBucket(i);
+    }
+    return 0;
+}
+
+// Calls of a block answered without python: memoized outputs and held minor steps.
+// Returns 0 on success, -1 on an invalid index.
+extern "C" int BasicPythonSupportInstrumentationSkippedCalls(int blockIndex, uint64_t* memoHits, uint64_t* minorStepHolds) {
+    auto blocks = BlockTypeSupports::BasicPythonSupport::InstrumentationRegistry::Instance().GetBlocks();
+    if (blockIndex < 0 || blockIndex >= (int)blocks.size()) return -1;
+    if (memoHits) *memoHits = blocks[blockIndex]->GetMemoHits();
+    if (minorStepHolds) *minorStepHolds = blocks[blockIndex]->GetMinorStepHolds();
+    return 0;
+}
+
+// Python heap usage of the sampled compute() calls of a block, see BasicPythonSupport/memoryTracking.
+// Returns 0 on success, -1 on an invalid index.
+extern "C" int BasicPythonSupportInstrumentationMemory(int blockIndex, uint64_t* samples, int64_t* retainedBytes,
+                                                      uint64_t* totalTransientBytes, uint64_t* maxTransientBytes) {
+    auto blocks = BlockTypeSupports::BasicPythonSupport::InstrumentationRegistry::Instance().GetBlocks();
+    if (blockIndex < 0 || blockIndex >= (int)blocks.size()) return -1;
+    const auto& memory = blocks[blockIndex]->GetMemory();
+    if (samples) *samples = memory.GetSamples();
+    if (retainedBytes) *retainedBytes = memory.GetRetainedBytes();
+    if (totalTransientBytes) *totalTransientBytes = memory.GetTotalTransientBytes();
+    if (maxTransientBytes) *maxTransientBytes = memory.GetMaxTransientBytes();
+    return 0;
+}
+
+// Writes a report now, CSV if path ends in .csv, JSON otherwise
+extern "C" void BasicPythonSupportWriteInstrumentationReport(const char* path) {
+    std::string reportPath = path;
+    auto& registry = BlockTypeSupports::BasicPythonSupport::InstrumentationRegistry::Instance();
+    if (reportPath.size() >= 4 && reportPath.compare(reportPath.size() - 4, 4, ".csv") == 0) {
+        registry.WriteCsv(reportPath);
+    } else {
+        registry.WriteJson(reportPath);
+    }
+}
+
+// Checkpoint of every python block as it is now, to be restored with BasicPythonSupport/restoreCheckpoint.
+// Call between steps; time is the simulation time the blocks are about to be computed at.
+// Returns 0 on success, -1 if a block state could not be saved or the file not written.
+extern "C" int BasicPythonSupportSaveCheckpoint(const char* path, double time) {
+    try {
+        BlockTypeSupports::BasicPythonSupport::CheckpointRegistry::Instance().SaveNow(path, time);
+    } catch (std::exception& e) {
+        spdlog::error("Could not save checkpoint {}: {}", path, e.what());
+        return -1;
+    }
+    return 0;
+}
@@ -5,10 +5,15 @@
 
 #include <Python.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
 #include <complex>
+#include <limits>
 #include <stdexcept>
 #include <type_traits>
 
@@ -21,6 +26,18 @@
 #include <spdlog/spdlog.h>
 
 #include "ConfigurationValueManager.h"
+#include "PythonExecutor.h"
+#include "PythonClassCache.h"
+#include "ConfigurationMapping.h"
+#include "BlockInstrumentation.h"
+#include "PythonMemoryProbe.h"
+#include "BlockCheckpoint.h"
+#include "BlockTrace.h"
+#include "FusedBlockGroup.h"
+#include "LookupTableSurrogate.h"
+#include "NativeKernel.h"
+#include "PortBuffer.h"
+#include "TypedSignalHandle.h"
 #include "SimulationBlockPythonConversions.h"
 
 namespace BlockTypeSupports::BasicPythonSupport
@@ -29,7 +46,14 @@ namespace BlockTypeSupports::BasicPythonSupport
 /*
  * Minimal templated Python-backed ISimulationBlock.
  *
- * Supported T: double, std::complex<double>
+ * Supported T: double, std::complex<double>, std::vector<double>, std::vector<std::complex<double>>
+ *
+ * Vector payloads have the fixed shape given by SignalShape (e.g. [64] or [3, 3]) on every port
+ * and are stored contiguously in one buffer per direction. Where the description below says
+ * "list of outputs", each array port is handed to python as a read-only memoryview of that shape
+ * and read back from anything with that many elements: a buffer (e.g. a numpy array) or a
+ * (nested) sequence. The views are refilled in place every step, copy them to keep values.
+ * Complex views use the "Zd" format, which numpy reads but memoryview cannot index.
  *
  * Expected Python API:
  *   class MyBlock:
@@ -37,25 +61,123 @@ namespace BlockTypeSupports::BasicPythonSupport
  *           ...
  *       def compute(self, inputs: list, t: float) -> list:
  *           # return list of outputs (same length as NumOutputs)
+ *
+ * With PortExchange: "Buffer" the signature becomes
+ *       def compute(self, inputs: memoryview, outputs: memoryview, t: float) -> None:
+ *           # inputs is read-only, outputs must be filled in place;
+ *           # numpy.asarray() wraps either view without copying
+ *   The views point to storage owned by the block and must not outlive it.
+ *   For vector payloads the views have shape (NumInputs, *SignalShape) and (NumOutputs, *SignalShape).
+ *
+ * Optionally, for windows of sample hits evaluated through ComputeBatch():
+ *       def compute_batch(self, times: memoryview, inputs: memoryview):
+ *           # times has shape (steps,), inputs (steps, NumInputs[, *SignalShape]);
+ *           # return a (steps, NumOutputs[, *SignalShape]) array or a list of per-step lists.
+ *           # The views are released when the call returns.
+ *
+ * Optionally, a class attribute declaring compute() free of internal state:
+ *       pure = True               # or "inputs": outputs depend on the inputs only
+ *       pure = "inputs_and_time"  # outputs depend on the inputs and t only
+ *   compute() is then skipped, and the previous outputs kept, while the inputs (and t)
+ *   are bit-identical to the previous call.
+ *
+ * Optionally, a sample time published to the engine instead of inheriting one, as an attribute or a method:
+ *       sample_time = 0.1           # discrete period in seconds, or (period, offset)
+ *       def sample_time(self): ...  # same values, evaluated once after __init__
+ *   0 or "continuous" is continuous, float("inf") or "constant" is constant (compute() runs once
+ *   and its outputs are kept), None, -1 or "inherited" keep the inherited default.
+ *   Offsets other than 0 are not supported by the engine's discrete sample times and are ignored.
+ *
+ * Optionally, a compiled kernel replacing compute() (see NativeKernel):
+ *       native_kernel = my_cfunc   # called on every step from C++, without the GIL
+ *   compute() is then optional, inputs and outputs are the flat element buffers
+ *   also used in buffer exchange mode.
+ *
+ * MinorStepPolicy: "HoldMajor" skips compute() on solver minor steps and keeps the outputs
+ * of the last major step, "Compute" (default) evaluates every call.
+ *
+ * TraceMode: "Record" appends (t, inputs, outputs) of every computed step to TracePath,
+ * "Replay" serves the outputs from that trace while t and the inputs match the recording
+ * (see BlockTrace). TraceMismatch "Compute" computes the calls missing from it, "Error" throws on them;
+ * empty (the default) picks "Compute" for blocks declaring pure and "Error" otherwise, since a stateful
+ * instance never ran the replayed steps and would compute from stale state.
+ *
+ * Surrogate: "Table" replaces compute() of a double block declaring pure = "inputs" (or True)
+ * by a multilinear lookup table (see LookupTableSurrogate), sampled from compute() after
+ * initialize() on SurrogatePoints grid points per input over SurrogateRanges ([low, high] per input).
+ * Inputs outside the ranges still call compute(). With SurrogateCheckPoints > 0 the table is
+ * compared with compute() at that many random points and dropped if off by more than SurrogateTolerance.
+ *
+ * FusionGroup/FusionIndex: member of a chain of blocks computed together under one GIL acquisition
+ * when the host evaluates the chain's head; followers must declare pure (see FusedBlockGroup,
+ * joined through BlockFactoryPython).
+ *
+ * With memory tracking enabled (see InstrumentationRegistry), every memorySampleInterval-th
+ * compute() call going through the interpreter is measured with tracemalloc (see PythonMemoryProbe).
+ *
+ * The block takes part in checkpoints (see CheckpointRegistry): the pickled python state, through
+ *       def get_state(self): ...          # optional, any picklable value, instance.__dict__ otherwise
+ *       def set_state(self, state): ...   # optional, __dict__.update(state) otherwise
+ * plus the output port values and memoization state. A checkpoint recorded for the block's id is
+ * restored right after initialize().
+ *
+ * Optionally, parameter changes applied to the live instance instead of rebuilding the block:
+ *       def update_configuration(self, key, value):
+ *           # value converted like the config entries; return False to refuse the change
+ *   Accepted updates drop memoized and held outputs and resample a surrogate table, which is dropped
+ *   if the new samples miss SurrogateTolerance. self.config keeps the values the block was built with;
+ *   the hook is the only place the new value reaches the instance. Keys read by the
+ *   bridge itself (see IsBridgeConfigurationKey), updates to replaying blocks and updates to blocks
+ *   computing through a native_kernel, which keeps the parameters it was built with, are refused.
+ *
+ * All python calls go through the IPythonExecutor the block was created with:
+ * the main interpreter by default, or a sub-interpreter worker (see SubInterpreterPool).
+ *
+ * With a PythonClassCache the class object is shared with every block of the same
+ * (PythonModule, PythonClass) on the same interpreter instead of being imported per block.
+ * The bound compute method and the inputs list are resolved once at construction.
+ * The inputs list is refilled in place on every step; if compute() keeps a
+ * reference to it, a fresh list is allocated for the next step instead.
  */
 
-template <typename T>
-class SimulationBlockPython : public PySysLinkBase::ISimulationBlock
+// BlockBase is ISimulationBlock, or ISimulationBlockWithContinuousStates for SimulationBlockPythonContinuous.
+// FixedInputs/FixedOutputs fix the port counts at compile time for scalar signals, so the
+// per-step port loops have constant bounds and the buffers live inline (see BlockFactoryPython).
+template <typename T, typename BlockBase = PySysLinkBase::ISimulationBlock,
+          int FixedInputs = DynamicPortCount, int FixedOutputs = DynamicPortCount>
+class SimulationBlockPython : public BlockBase, public IFusedPythonBlock, public ICheckpointableBlock
 {
+    static_assert(!SignalTraits<T>::IsArray || (FixedInputs == DynamicPortCount && FixedOutputs == DynamicPortCount),
+                  "fixed port counts are only supported for scalar signals");
+
+    // continuous states change between calls with identical arguments, so such blocks are never pure
+    static constexpr bool HasContinuousStates = !std::is_same_v<BlockBase, PySysLinkBase::ISimulationBlock>;
 
 public:
+    // scalar type of the port buffers, T itself for scalar signals
+    using Element = typename SignalTraits<T>::Element;
+
+    // What compute() depends on, declared by the python class through its pure attribute
+    enum class Purity
+    {
+        None,          // stateful or unknown, always called
+        InputsAndTime, // cached while inputs and t are unchanged
+        InputsOnly     // cached while inputs are unchanged
+    };
+
     SimulationBlockPython(std::map<std::string, PySysLinkBase::ConfigurationValue> blockConfiguration,
-                          std::shared_ptr<PySysLinkBase::IBlockEventsHandler> eventsHandler)
-        : ISimulationBlock(blockConfiguration, eventsHandler)
+                          std::shared_ptr<PySysLinkBase::IBlockEventsHandler> eventsHandler,
+                          std::shared_ptr<IPythonExecutor> executor = MainInterpreterExecutor::Instance(),
+                          std::shared_ptr<PythonClassCache> classCache = nullptr,
+                          std::shared_ptr<ConfigurationMappingCache> configurationCache = nullptr)
+        : BlockBase(blockConfiguration, eventsHandler), executor(executor)
     {
         // read configuration
         moduleName = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("PythonModule", blockConfiguration);
         className = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("PythonClass", blockConfiguration);
 
-        std::vector<PySysLinkBase::SampleTimeType> supportedSampleTimeTypes = {};
-        supportedSampleTimeTypes.push_back(PySysLinkBase::SampleTimeType::continuous);
-        supportedSampleTimeTypes.push_back(PySysLinkBase::SampleTimeType::discrete);
-        this->sampleTime = std::make_shared<PySysLinkBase::SampleTime>(PySysLinkBase::SampleTimeType::inherited, supportedSampleTimeTypes);
+        // inherited unless the python class declares its own, see ParseSampleTime()
+        this->sampleTime = InheritedSampleTime();
 
         // optional: number of ports
         try {
@@ -69,88 +191,418 @@ public:
             numOutputs = 1;
         }
 
+        // optional: port exchange mode, "List" (default) or "Buffer"
+        std::string portExchange = "List";
+        try {
+            portExchange = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("PortExchange", blockConfiguration);
+        } catch(std::out_of_range&) {
+            // default: List
+        }
+        if (portExchange == "Buffer")
+        {
+            bufferPortExchange = true;
+        }
+        else if (portExchange != "List")
+        {
+            throw std::invalid_argument("SimulationBlockPython: Unsupported PortExchange: " + portExchange);
+        }
+
+        // optional: minor step policy, "Compute" (default) or "HoldMajor"
+        std::string minorStepPolicy = "Compute";
+        try {
+            minorStepPolicy = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("MinorStepPolicy", blockConfiguration);
+        } catch(std::out_of_range&) {
+            // default: Compute
+        }
+        if (minorStepPolicy == "HoldMajor")
+        {
+            holdOnMinorSteps = true;
+        }
+        else if (minorStepPolicy != "Compute")
+        {
+            throw std::invalid_argument("SimulationBlockPython: Unsupported MinorStepPolicy: " + minorStepPolicy);
+        }
+
+        // optional: I/O trace, TraceMode "Off" (default), "Record" or "Replay", with TracePath
+        std::string traceModeName = "Off";
+        try {
+            traceModeName = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("TraceMode", blockConfiguration);
+        } catch(std::out_of_range&) {
+            // default: Off
+        }
+        if (traceModeName == "Record")
+        {
+            traceMode = TraceMode::Record;
+        }
+        else if (traceModeName == "Replay")
+        {
+            traceMode = TraceMode::Replay;
+        }
+        else if (traceModeName != "Off")
+        {
+            throw std::invalid_argument("SimulationBlockPython: Unsupported TraceMode: " + traceModeName);
+        }
+        if (traceMode != TraceMode::Off)
+        {
+            try {
+                tracePath = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("TracePath", blockConfiguration);
+            } catch(std::out_of_range&) {
+                throw std::invalid_argument("SimulationBlockPython: TraceMode " + traceModeName + " needs a TracePath");
+            }
+        }
+
+        // optional: replayed call missing from the trace, "Compute", "Error" or empty to pick by purity
+        std::string traceMismatch;
+        try {
+            traceMismatch = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("TraceMismatch", blockConfiguration);
+        } catch(std::out_of_range&) {
+            // default: decided once the purity declaration is known, see below
+        }
+        if (traceMismatch == "Error")
+        {
+            traceMismatchError = true;
+        }
+        else if (!traceMismatch.empty() && traceMismatch != "Compute")
+        {
+            throw std::invalid_argument("SimulationBlockPython: Unsupported TraceMismatch: " + traceMismatch);
+        }
+
+        // optional: lookup-table surrogate, Surrogate "Off" (default) or "Table"
+        std::string surrogateName = "Off";
+        try {
+            surrogateName = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("Surrogate", blockConfiguration);
+        } catch(std::out_of_range&) {
+            // default: Off
+        }
+        if (surrogateName != "Off" && surrogateName != "Table")
+        {
+            throw std::invalid_argument("SimulationBlockPython: Unsupported Surrogate: " + surrogateName);
+        }
+
+        // the table is validated here, before any python object exists, and sampled after initialize()
+        std::unique_ptr<LookupTableSurrogate> pendingSurrogate;
+        if (surrogateName == "Table")
+        {
+            std::vector<double> ranges;
+            std::vector<int> points = {65};
+            try {
+                ranges = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::vector<double>>("SurrogateRanges", blockConfiguration);
+            } catch(std::out_of_range&) {
+                throw std::invalid_argument("SimulationBlockPython: Surrogate Table needs SurrogateRanges");
+            }
+            try {
+                points = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::vector<int>>("SurrogatePoints", blockConfiguration);
+            } catch(std::out_of_range&) {
+                // default: [65]
+            }
+            try {
+                surrogateCheckPoints = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<int>("SurrogateCheckPoints", blockConfiguration);
+            } catch(std::out_of_range&) {
+                // default: no check
+            }
+            try {
+                surrogateTolerance = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<double>("SurrogateTolerance", blockConfiguration);
+            } catch(std::out_of_range&) {
+                // default: report the error only
+            }
+            pendingSurrogate = std::make_unique<LookupTableSurrogate>(numInputs, numOutputs, ranges, points);
+        }
+
+        if constexpr (SignalTraits<T>::IsArray)
+        {
+            // shape of every port's payload, default: one element
+            std::vector<int> shape = {1};
+            try {
+                shape = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::vector<int>>("SignalShape", blockConfiguration);
+            } catch(std::out_of_range&) {
+                // default: [1]
+            }
+            if (shape.empty() || shape.size() > 8)
+            {
+                throw std::invalid_argument("SimulationBlockPython: SignalShape must have between 1 and 8 dimensions");
+            }
+            for (int extent : shape)
+            {
+                if (extent <= 0)
+                {
+                    throw std::invalid_argument("SimulationBlockPython: SignalShape extents must be positive");
+                }
+                signalShape.push_back(extent);
+                signalWidth *= static_cast<size_t>(extent);
+            }
+        }
+
+        if ((FixedInputs != DynamicPortCount && numInputs != FixedInputs) ||
+            (FixedOutputs != DynamicPortCount && numOutputs != FixedOutputs))
+        {
+            throw std::invalid_argument("SimulationBlockPython: port numbers do not match the fixed port count specialization");
+        }
+
+        // opened before any python object exists, so a bad trace leaves nothing to release
+        if (traceMode != TraceMode::Off)
+        {
+            TraceLayout layout;
+            layout.elementFormat = BufferFormat<Element>();
+            layout.elementSize = sizeof(Element);
+            layout.inputCount = static_cast<uint32_t>(numInputs * signalWidth);
+            layout.outputCount = static_cast<uint32_t>(numOutputs * signalWidth);
+            if (traceMode == TraceMode::Record)
+            {
+                traceWriter = std::make_unique<BlockTraceWriter>(tracePath, layout);
+            }
+            else
+            {
+                traceReader = std::make_unique<BlockTraceReader>(tracePath, layout);
+            }
+        }
+
         // create ports
         for (int i = 0; i < numInputs; ++i)
         {
-            std::shared_ptr<PySysLinkBase::UnknownTypeSignalValue> signalValue = std::make_shared<PySysLinkBase::SignalValue<T>>(PySysLinkBase::SignalValue<T>(0.0));
+            std::shared_ptr<PySysLinkBase::UnknownTypeSignalValue> signalValue = std::make_shared<PySysLinkBase::SignalValue<T>>(PySysLinkBase::SignalValue<T>(InitialPayload()));
             auto inputPort = std::make_shared<PySysLinkBase::InputPort>(PySysLinkBase::InputPort(false, signalValue));
             inputPorts.push_back(inputPort);
         }
+        outputValues.assign(numOutputs, nullptr);
         for (int i = 0; i < numOutputs; ++i)
         {
-            std::shared_ptr<PySysLinkBase::UnknownTypeSignalValue> signalValue = std::make_shared<PySysLinkBase::SignalValue<T>>(PySysLinkBase::SignalValue<T>(0.0));
-            auto outputPort = std::make_shared<PySysLinkBase::OutputPort>(PySysLinkBase::OutputPort(signalValue));
+            outputValues[i] = std::make_shared<PySysLinkBase::SignalValue<T>>(PySysLinkBase::SignalValue<T>(InitialPayload()));
+            auto outputPort = std::make_shared<PySysLinkBase::OutputPort>(PySysLinkBase::OutputPort(outputValues[i]));
             this->outputPorts.push_back(outputPort);
         }
 
+        // resolve the typed input values once, steps re-cast only when a port hands out another value
+        inputSignals.assign(numInputs, TypedSignalHandle<T>());
+        for (int i = 0; i < numInputs; ++i) inputSignals[i].Resolve(inputPorts[i]->GetValue());
+
         // Prepare python and instantiate the class
-        PyGILState_STATE gstate = PyGILState_Ensure();
+        executor->Execute([&] {
+            if (classCache)
+            {
+                // shared with every block of the same class on this interpreter
+                pyClass = classCache->GetClass(this->executor, moduleName, className);
+            }
+            else
+            {
+                PyObject* pyName = PyUnicode_FromString(moduleName.c_str());
+                pyModule = PyImport_Import(pyName);
+                Py_DECREF(pyName);
 
-        PyObject* sysPath = PySys_GetObject("path");  // borrowed ref
-        Py_ssize_t n = PyList_Size(sysPath);
+                if (!pyModule)
+                {
+                    throw std::runtime_error("SimulationBlockPython: Could not import module: " + moduleName);
+                }
 
-        spdlog::info("Python sys.path has {} entries:", n);
+                pyClass = PyObject_GetAttrString(pyModule, className.c_str());
+                if (!pyClass || !PyCallable_Check(pyClass))
+                {
+                    Py_XDECREF(pyClass);
+                    Py_DECREF(pyModule);
+                    throw std::runtime_error("SimulationBlockPython: Class not found or not callable: " + className);
+                }
+            }
 
-        for (Py_ssize_t i = 0; i < n; ++i) {
-            PyObject* item = PyList_GetItem(sysPath, i);  // borrowed ref
-            const char* pathStr = PyUnicode_AsUTF8(item);
-            if (pathStr) {
-                spdlog::info("  [{}] {}", i, pathStr);
+            // shared read-only mapping converting values on first access, or a plain dict without a cache
+            PyObject* pyConfig = nullptr;
+            if (configurationCache)
+            {
+                try {
+                    pyConfig = configurationCache->GetMapping(this->executor, blockConfiguration);
+                } catch (...) {
+                    Py_DECREF(pyClass);
+                    Py_XDECREF(pyModule);
+                    throw;
+                }
             }
-        }
+            else
+            {
+                pyConfig = PyDict_New();
+                for (auto& kv : blockConfiguration) {
+                    PyObject* pyVal = PySysLinkBase::ConfigurationValueToPyObject(kv.second);
+                    PyDict_SetItemString(pyConfig, kv.first.c_str(), pyVal);
+                    Py_DECREF(pyVal);
+                }
+            }
+
+            // instantiate: cls(config)
+            pyInstance = PyObject_CallFunctionObjArgs(pyClass, pyConfig, NULL);
+            Py_DECREF(pyConfig);
+
+            if (!pyInstance)
+            {
+                Py_DECREF(pyClass);
+                Py_XDECREF(pyModule);
+                throw std::runtime_error("SimulationBlockPython: Could not instantiate class: " + className);
+            }
+
+            // optional compiled kernel, called instead of compute()
+            try {
+                nativeKernel.Resolve(pyInstance);
+            } catch (...) {
+                Py_DECREF(pyInstance);
+                Py_DECREF(pyClass);
+                Py_XDECREF(pyModule);
+                throw;
+            }
+            if (nativeKernel.IsResolved() && nativeKernel.GetSignature() == NativeKernelSignature::InOutCountTime &&
+                numInputs != numOutputs)
+            {
+                nativeKernel.Release();
+                Py_DECREF(pyInstance);
+                Py_DECREF(pyClass);
+                Py_XDECREF(pyModule);
+                throw std::invalid_argument("SimulationBlockPython: native_signature in_out_n_t needs as many inputs as outputs on: " + className);
+            }
+
+            // resolve bound compute method once, steady-state calls go through vectorcall
+            pyCompute = PyObject_GetAttrString(pyInstance, "compute");
+            if (!pyCompute && nativeKernel.IsResolved())
+            {
+                PyErr_Clear();
+            }
+            else if (!pyCompute || !PyCallable_Check(pyCompute))
+            {
+                Py_XDECREF(pyCompute);
+                Py_DECREF(pyInstance);
+                Py_DECREF(pyClass);
+                Py_XDECREF(pyModule);
+                throw std::runtime_error("SimulationBlockPython: compute() not found or not callable on: " + className);
+            }
+
+            // from here on the instance exists; the destructor does not run for a constructor that throws
+            try
+            {
+                inputBuffer.assign(numInputs * signalWidth, Element(0.0));
+                outputBuffer.assign(numOutputs * signalWidth, Element(0.0));
+                if (bufferPortExchange)
+                {
+                    pyInputView = ToPyMemoryView<Element>(inputBuffer.data(), PortsShape(numInputs), true);
+                    pyOutputView = ToPyMemoryView<Element>(outputBuffer.data(), PortsShape(numOutputs), false);
+                }
+                else if (SignalTraits<T>::IsArray)
+                {
+                    // one persistent view per input port, placed in the inputs list instead of boxed values
+                    for (int i = 0; i < numInputs; ++i)
+                    {
+                        pyPortViews.push_back(ToPyMemoryView<Element>(inputBuffer.data() + i * signalWidth, signalShape, true));
+                    }
+                }
+
+                // preallocated inputs list, reused on every step while python does not hold on to it
+                pyInputs = NewInputsList();
+
+                // optional batched entry point
+                if (PyObject_HasAttrString(pyInstance, "compute_batch"))
+                {
+                    pyComputeBatch = PyObject_GetAttrString(pyInstance, "compute_batch");
+                    if (pyComputeBatch && !PyCallable_Check(pyComputeBatch))
+                    {
+                        Py_CLEAR(pyComputeBatch);
+                    }
+                }
+
+                // optional hook for live parameter updates
+                if (PyObject_HasAttrString(pyInstance, "update_configuration"))
+                {
+                    pyUpdateConfiguration = PyObject_GetAttrString(pyInstance, "update_configuration");
+                    if (pyUpdateConfiguration && !PyCallable_Check(pyUpdateConfiguration))
+                    {
+                        Py_CLEAR(pyUpdateConfiguration);
+                    }
+                }
 
-        PyObject* pyName = PyUnicode_FromString(moduleName.c_str());
-        pyModule = PyImport_Import(pyName);
-        Py_DECREF(pyName);
+                // optional purity declaration, decided here since the surrogate, TraceMismatch
+                // and a restored checkpoint below all depend on it
+                if (PyObject_HasAttrString(pyInstance, "pure"))
+                {
+                    PyObject* pyPure = PyObject_GetAttrString(pyInstance, "pure");
+                    purity = ParsePurity(pyPure);
+                    Py_XDECREF(pyPure);
+                    if (HasContinuousStates && purity != Purity::None)
+                    {
+                        spdlog::warn("SimulationBlockPython: {} has continuous states, ignoring its pure declaration", className);
+                        purity = Purity::None;
+                    }
+                }
 
-        if (!pyModule)
+                // optional sample time declaration, an attribute or a sample_time() method
+                if (PyObject_HasAttrString(pyInstance, "sample_time"))
+                {
+                    PyObject* pySampleTime = PyObject_GetAttrString(pyInstance, "sample_time");
+                    if (pySampleTime && PyCallable_Check(pySampleTime))
+                    {
+                        PyObject* pyDeclared = PyObject_CallObject(pySampleTime, nullptr);
+                        Py_DECREF(pySampleTime);
+                        pySampleTime = pyDeclared;
+                    }
+                    if (pySampleTime)
+                    {
+                        ParseSampleTime(pySampleTime);
+                        Py_DECREF(pySampleTime);
+                    }
+                    else
+                    {
+                        PyErr_Print();
+                        spdlog::warn("SimulationBlockPython: sample_time of {} failed, the sample time stays inherited", className);
+                    }
+                }
+            }
+            catch (...)
+            {
+                ReleasePythonObjects();
+                throw;
+            }
+        });
+
+        // default TraceMismatch: a stateful instance cannot pick up where the replayed steps left it
+        if (traceMismatch.empty())
         {
-            PyGILState_Release(gstate);
-            throw std::runtime_error("SimulationBlockPython: Could not import module: " + moduleName);
+            traceMismatchError = purity == Purity::None;
         }
 
-        pyClass = PyObject_GetAttrString(pyModule, className.c_str());
-        if (!pyClass || !PyCallable_Check(pyClass))
+        try
         {
-            Py_XDECREF(pyClass);
-            Py_DECREF(pyModule);
-            PyGILState_Release(gstate);
-            throw std::runtime_error("SimulationBlockPython: Class not found or not callable: " + className);
-        }
+            instrumentation = InstrumentationRegistry::Instance().Register(this->GetId().empty() ? className : this->GetId());
+            memorySampleInterval = InstrumentationRegistry::Instance().GetMemorySampleInterval();
+            if (instrumentation && memorySampleInterval > 0)
+            {
+                executor->Execute([this] {
+                    memoryProbe.Resolve();
+                });
+            }
 
-        // build Python dict from blockConfiguration (simple string values)
-        PyObject* pyConfig = PyDict_New();
-        for (auto& kv : blockConfiguration) {
-            PyObject* pyVal = PySysLinkBase::ConfigurationValueToPyObject(kv.second);
-            PyDict_SetItemString(pyConfig, kv.first.c_str(), pyVal);
-            Py_DECREF(pyVal);
-        }
+            // Optionally call initialize() on python side if exists
+            CallOptionalVoidMethod("initialize");
 
-        // instantiate: cls(config)
-        pyInstance = PyObject_CallFunctionObjArgs(pyClass, pyConfig, NULL);
-        Py_DECREF(pyConfig);
+            if (pendingSurrogate)
+            {
+                BuildSurrogate(std::move(pendingSurrogate), surrogateCheckPoints, surrogateTolerance);
+            }
 
-        if (!pyInstance)
+            if (const BlockCheckpointRecord* record = CheckpointRegistry::Instance().FindRestored(GetCheckpointId()))
+            {
+                RestoreCheckpoint(*record);
+            }
+        }
+        catch (...)
         {
-            Py_DECREF(pyClass);
-            Py_DECREF(pyModule);
-            PyGILState_Release(gstate);
-            throw std::runtime_error("SimulationBlockPython: Could not instantiate class: " + className);
+            executor->Execute([this] {
+                ReleasePythonObjects();
+            });
+            throw;
         }
-
-        PyGILState_Release(gstate);
-
-        // Optionally call initialize() on python side if exists
-        CallOptionalVoidMethod("initialize");
+        // last, so a block that failed to construct is never asked for a checkpoint
+        CheckpointRegistry::Instance().Register(this);
     }
 
     ~SimulationBlockPython()
     {
-        PyGILState_STATE gstate = PyGILState_Ensure();
-        Py_XDECREF(pyInstance);
-        Py_XDECREF(pyClass);
-        Py_XDECREF(pyModule);
-        PyGILState_Release(gstate);
+        CheckpointRegistry::Instance().Unregister(this);
+        if (fusedGroup) fusedGroup->Remove(this);
+
+        executor->Execute([this] {
+            ReleasePythonObjects();
+        });
     }
 
     // ISimulationBlock required overrides
@@ -174,103 +626,1150 @@ public:
         return this->outputPorts;
     }
 
-    // Main compute bridge: calls python_instance.compute(inputs, currentTime)
+    // Main compute bridge: calls python_instance.compute(inputs, currentTime),
+    // or python_instance.compute(inputs, outputs, currentTime) in buffer exchange mode
     const std::vector<std::shared_ptr<PySysLinkBase::OutputPort>> _ComputeOutputsOfBlock(
         const std::shared_ptr<PySysLinkBase::SampleTime> sampleTime, double currentTime, bool isMinorStep = false) override
     {
-        PyGILState_STATE gstate = PyGILState_Ensure();
+        // time-triggered checkpoint, the state entering the first major step at or after the checkpoint time
+        if (!isMinorStep && !checkpointStored && currentTime >= CheckpointRegistry::Instance().GetSaveTime())
+        {
+            checkpointStored = true;
+            try {
+                CheckpointRegistry::Instance().Store(SaveCheckpoint(currentTime));
+            } catch (std::runtime_error& e) {
+                // e.g. an unpicklable attribute, the run goes on without this block's record
+                spdlog::warn("SimulationBlockPython: {} left out of the checkpoint: {}", className, e.what());
+                CheckpointRegistry::Instance().Skip(GetCheckpointId());
+            }
+        }
 
-        // Build Python list of inputs
-        PyObject* pyInputs = PyList_New(inputPorts.size());
-        for (size_t i = 0; i < inputPorts.size(); ++i)
+        // a constant block's ports hold the outputs of its only evaluation
+        if (declaredSampleTimeType == PySysLinkBase::SampleTimeType::constant && hasConstantOutputs)
         {
-            auto inputValue = this->inputPorts[i]->GetValue();
-            auto inputValueSignal = inputValue->TryCastToTyped<T>();
-            PyObject* pyv = ToPyObject<T>(inputValueSignal->GetPayload());
-            PyList_SetItem(pyInputs, (Py_ssize_t)i, pyv); // steals reference
+            return outputPorts;
         }
 
+        // the output ports still hold the outputs of the last major step
+        if (isMinorStep && holdOnMinorSteps && hasMajorStepOutputs)
+        {
+            ++minorStepHoldCount;
+            if (instrumentation) instrumentation->CountMinorStepHold();
+            return outputPorts;
+        }
+
+        timingStep = instrumentation != nullptr;
+        if (timingStep) phaseStart = BlockInstrumentation::Clock::now();
+
+        for (size_t i = 0; i < InputCount(); ++i)
+        {
+            ReadInput(i, inputBuffer.data() + i * signalWidth);
+        }
+
+        if (purity != Purity::None)
+        {
+            bool timeMatches = purity == Purity::InputsOnly || currentTime == memoTime;
+            if (hasMemoOutputs && timeMatches &&
+                std::memcmp(inputBuffer.data(), memoInputs.data(), inputBuffer.size() * sizeof(Element)) == 0)
+            {
+                // the output ports still hold the outputs computed for these inputs
+                ++memoHitCount;
+                if (instrumentation) instrumentation->CountMemoHit();
+                timingStep = false;
+                if (!isMinorStep) hasMajorStepOutputs = true;
+                return outputPorts;
+            }
+            ++memoMissCount;
+            memoInputs = inputBuffer;
+            memoTime = currentTime;
+        }
+        // cleared until this call's outputs are in the ports
+        hasMemoOutputs = false;
+        portReadNanoseconds = EndPhase();
+
+        if (!ReplayStep(currentTime))
+        {
+            if (fusedGroup && TakeFusedOutputs(currentTime))
+            {
+                // computed with the chain of the group's head
+            }
+            else if (fusedGroup && fusedGroup->Evaluate(*this, currentTime, isMinorStep))
+            {
+                // head of the group, computed together with the rest of the chain
+            }
+            else if (surrogate && EvaluateSurrogate())
+            {
+                // interpolated, no interpreter involved
+            }
+            else if (nativeKernel.IsResolved())
+            {
+                // compiled kernel, no interpreter involved
+                ComputeNative(currentTime);
+            }
+            else if (memoryProbe.IsResolved() && ++callsSinceMemorySample >= memorySampleInterval)
+            {
+                callsSinceMemorySample = 0;
+                executor->Execute([this, currentTime] {
+                    RecordPhase(BridgePhase::GilAcquire);
+                    memoryProbe.Begin();
+                    ComputeStep(currentTime);
+                    MemorySample sample = memoryProbe.End();
+                    instrumentation->RecordMemory(sample.retainedBytes, sample.transientBytes,
+                                                  InstrumentationRegistry::Instance().GetMemoryWarningBytes());
+                });
+            }
+            else
+            {
+                executor->Execute([this, currentTime] {
+                    RecordPhase(BridgePhase::GilAcquire);
+                    ComputeStep(currentTime);
+                });
+            }
+            if (traceWriter) traceWriter->Append(currentTime, inputBuffer.data(), outputBuffer.data());
+        }
+
+        for (size_t i = 0; i < OutputCount(); ++i)
+        {
+            WriteOutput(i, outputBuffer.data() + i * signalWidth);
+        }
+        hasMemoOutputs = purity != Purity::None;
+        if (!isMinorStep) hasMajorStepOutputs = true;
+        hasConstantOutputs = true;
+
+        if (timingStep)
+        {
+            RecordPhase(BridgePhase::Writeback);
+            instrumentation->CountCall();
+            timingStep = false;
+        }
+        return outputPorts;
+    }
+
+    // True if the python class defines compute_batch(times, inputs)
+    bool SupportsBatchCompute() const
+    {
+        return pyComputeBatch != nullptr;
+    }
+
+    // Evaluates a window of sample hits under a single GIL acquisition.
+    // inputs is row-major steps x NumInputs (x SignalShape), the result is row-major steps x NumOutputs (x SignalShape).
+    // Calls compute_batch(times, inputs) with views when available, otherwise compute() once per step.
+    // Output ports are left holding the outputs of the last step.
+    std::vector<Element> ComputeBatch(const std::vector<double>& times, const std::vector<Element>& inputs)
+    {
+        static_assert(!std::is_same_v<Element, bool>, "ComputeBatch needs contiguous elements, not available for bool signals");
+        size_t steps = times.size();
+        size_t inputStride = inputBuffer.size();
+        size_t outputStride = outputBuffer.size();
+        if (inputs.size() != steps * inputStride)
+        {
+            throw std::invalid_argument("SimulationBlockPython: ComputeBatch inputs size does not match steps x NumInputs");
+        }
+
+        std::vector<Element> outputs(steps * outputStride);
+        // ports no longer match the memoized inputs
+        hasMemoOutputs = false;
+
+        if (nativeKernel.IsResolved())
+        {
+            for (size_t k = 0; k < steps; ++k)
+            {
+                nativeKernel.Call<Element>(inputs.data() + k * inputStride, inputStride, outputs.data() + k * outputStride, outputStride, times[k]);
+            }
+        }
+        else
+        {
+            executor->Execute([&] {
+                if (pyComputeBatch)
+                {
+                    ComputeBatchWithPython(times, inputs, outputs);
+                }
+                else
+                {
+                    for (size_t k = 0; k < steps; ++k)
+                    {
+                        std::copy(inputs.begin() + k * inputStride, inputs.begin() + (k + 1) * inputStride, inputBuffer.begin());
+                        ComputeStep(times[k]);
+                        std::copy(outputBuffer.begin(), outputBuffer.end(), outputs.begin() + k * outputStride);
+                    }
+                }
+            });
+        }
+
+        if (steps > 0)
+        {
+            for (size_t i = 0; i < outputPorts.size(); ++i)
+            {
+                WriteOutput(i, outputs.data() + (steps - 1) * outputStride + i * signalWidth);
+            }
+        }
+        return outputs;
+    }
+
+    // Number of times the inputs list had to be reallocated because python kept a reference to it.
+    // Stays constant in steady state.
+    unsigned long long GetArgumentAllocationCount() const
+    {
+        return argumentAllocationCount;
+    }
+
+    // Python objects the bridge created for compute() calls: the inputs list replacements above, the
+    // boxed scalar inputs and time, and the list copy of a result that is neither a list nor a tuple.
+    // Float and complex inputs and the time are refilled in place while python keeps no reference
+    // to them, so in steady state only Int64 and Bool inputs are boxed every step (CPython shares
+    // bools and small ints, so those do not allocate either). Counted by the bridge, see
+    // Tests/TestPythonAllocations.cpp for the interpreter's own count.
+    unsigned long long GetObjectAllocationCount() const
+    {
+        return objectAllocationCount;
+    }
+
+    Purity GetPurity() const
+    {
+        return purity;
+    }
+
+    // Sample time type declared by the python class, inherited if it declares none
+    PySysLinkBase::SampleTimeType GetDeclaredSampleTimeType() const
+    {
+        return declaredSampleTimeType;
+    }
+
+    // Calls answered from the memoized outputs of a pure block
+    unsigned long long GetMemoHitCount() const
+    {
+        return memoHitCount;
+    }
+
+    // Calls of a pure block that had to go to python
+    unsigned long long GetMemoMissCount() const
+    {
+        return memoMissCount;
+    }
+
+    // Minor steps answered with the last major step outputs (MinorStepPolicy HoldMajor)
+    unsigned long long GetMinorStepHoldCount() const
+    {
+        return minorStepHoldCount;
+    }
+
+    // Calls answered by the lookup-table surrogate, and calls it left to compute() (inputs out of range)
+    unsigned long long GetSurrogateHitCount() const
+    {
+        return surrogateHitCount;
+    }
+
+    unsigned long long GetSurrogateMissCount() const
+    {
+        return surrogateMissCount;
+    }
+
+    // Calls answered from the outputs computed with the chain of a fused group, and those that
+    // had to compute again since t or the inputs differed from what the chain fed the block
+    unsigned long long GetFusedHitCount() const
+    {
+        return fusedHitCount;
+    }
+
+    unsigned long long GetFusedMissCount() const
+    {
+        return fusedMissCount;
+    }
+
+    // IFusedPythonBlock
+    FusedPortLayout GetFusedLayout() const override
+    {
+        FusedPortLayout layout;
+        layout.elementFormat = BufferFormat<Element>();
+        layout.elementSize = sizeof(Element);
+        layout.inputCount = inputBuffer.size();
+        layout.outputCount = outputBuffer.size();
+        return layout;
+    }
+
+    bool CanComputeAhead() const override
+    {
+        return purity != Purity::None;
+    }
+
+    bool FusedCompute(double time, bool isMinorStep, const void* inputs) override
+    {
+        if (!inputs)
+        {
+            // the head, inputs already read from its ports
+            RecordPhase(BridgePhase::GilAcquire);
+            if (!(surrogate && EvaluateSurrogate())) ComputeStep(time);
+            return true;
+        }
+
+        // a follower holding its major step or constant outputs, or replaying them, is not computed
+        if ((isMinorStep && holdOnMinorSteps && hasMajorStepOutputs) || traceReader ||
+            (declaredSampleTimeType == PySysLinkBase::SampleTimeType::constant && hasConstantOutputs))
+        {
+            return false;
+        }
+        std::memcpy(inputBuffer.data(), inputs, inputBuffer.size() * sizeof(Element));
+        fusedInputs = inputBuffer;
+        fusedTime = time;
+        if (!(surrogate && EvaluateSurrogate())) ComputeStep(time);
+        hasFusedOutputs = true;
+        return true;
+    }
+
+    const void* GetFusedOutputs() const override
+    {
+        return outputBuffer.data();
+    }
+
+    void SetFusedGroup(std::shared_ptr<FusedBlockGroup> group) override
+    {
+        fusedGroup = std::move(group);
+    }
+
+    // ICheckpointableBlock
+    std::string GetCheckpointId() const override
+    {
+        return this->GetId().empty() ? className : this->GetId();
+    }
+
+    BlockCheckpointRecord SaveCheckpoint(double time) override
+    {
+        BlockCheckpointRecord record;
+        record.blockId = GetCheckpointId();
+        record.time = time;
+        record.elementFormat = BufferFormat<Element>();
+        record.elementSize = sizeof(Element);
+        record.inputCount = static_cast<uint32_t>(inputBuffer.size());
+        record.outputCount = static_cast<uint32_t>(outputBuffer.size());
+
+        const unsigned char* inputBytes = reinterpret_cast<const unsigned char*>(inputBuffer.data());
+        record.inputs.assign(inputBytes, inputBytes + inputBuffer.size() * sizeof(Element));
+
+        // from the ports, outputBuffer may hold a newer computation the ports never received
+        PortBuffer<Element, FixedOutputs> portOutputs;
+        portOutputs.assign(outputBuffer.size(), Element(0.0));
+        for (size_t i = 0; i < OutputCount(); ++i)
+        {
+            ReadOutput(i, portOutputs.data() + i * signalWidth);
+        }
+        const unsigned char* outputBytes = reinterpret_cast<const unsigned char*>(portOutputs.data());
+        record.outputs.assign(outputBytes, outputBytes + portOutputs.size() * sizeof(Element));
+
+        record.memoTime = memoTime;
+        record.flags = (hasMemoOutputs ? CheckpointMemoOutputs : 0u) |
+                       (hasMajorStepOutputs ? CheckpointMajorStepOutputs : 0u) |
+                       (hasConstantOutputs ? CheckpointConstantOutputs : 0u);
+        executor->Execute([&] {
+            record.pythonState = PicklePythonState(pyInstance);
+        });
+        return record;
+    }
+
+    // Calls update_configuration(key, value) on the python instance. False, and the block left as it
+    // was, if the class has no such hook, refuses the value, or the key is one the bridge reads itself.
+    // Also false for a native kernel: compute() is not called, the hook could not reach the kernel.
+    bool _TryUpdateConfigurationValue(std::string keyName, PySysLinkBase::ConfigurationValue value) override
+    {
+        if (!pyUpdateConfiguration || traceReader || nativeKernel.IsResolved() || IsBridgeConfigurationKey(keyName))
+        {
+            return false;
+        }
+
+        bool accepted = false;
+        executor->Execute([&] {
+            PyObject* pyKey = PyUnicode_FromString(keyName.c_str());
+            PyObject* pyValue = PySysLinkBase::ConfigurationValueToPyObject(value);
+            PyObject* pyResult = pyKey && pyValue ? PyObject_CallFunctionObjArgs(pyUpdateConfiguration, pyKey, pyValue, NULL) : nullptr;
+            Py_XDECREF(pyKey);
+            Py_XDECREF(pyValue);
+
+            // None (no return statement) accepts, like True
+            int truth = pyResult == Py_None ? 1 : pyResult ? PyObject_IsTrue(pyResult) : -1;
+            Py_XDECREF(pyResult);
+            if (truth < 0)
+            {
+                PyErr_Print();
+                spdlog::warn("SimulationBlockPython: update_configuration({}) failed on {}", keyName, className);
+            }
+            accepted = truth == 1;
+        });
+        if (!accepted)
+        {
+            return false;
+        }
+
+        // outputs held or cached for the previous value
+        hasMemoOutputs = false;
+        hasMajorStepOutputs = false;
+        hasConstantOutputs = false;
+        hasFusedOutputs = false;
+        if (surrogate)
+        {
+            BuildSurrogate(std::move(surrogate), surrogateCheckPoints, surrogateTolerance);
+            if (!surrogate)
+            {
+                spdlog::warn("SimulationBlockPython: {} lookup table dropped after update_configuration({}), every call goes through compute() from now on",
+                             className, keyName);
+            }
+        }
+        ++configurationUpdateCount;
+        return true;
+    }
+
+    // Updates applied to the live instance through update_configuration()
+    unsigned long long GetConfigurationUpdateCount() const
+    {
+        return configurationUpdateCount;
+    }
+
+protected:
+    // configuration
+    std::string moduleName;
+    std::string className;
+    int numInputs = 1;
+    int numOutputs = 1;
+    bool bufferPortExchange = false;
+    std::vector<Py_ssize_t> signalShape; // empty for scalar signals
+    size_t signalWidth = 1;              // elements per port
+    bool holdOnMinorSteps = false;
+
+    // ports and sample time
+    std::shared_ptr<PySysLinkBase::SampleTime> sampleTime;
+    PySysLinkBase::SampleTimeType declaredSampleTimeType = PySysLinkBase::SampleTimeType::inherited;
+    bool hasConstantOutputs = false; // the output ports hold the outputs of a constant block's evaluation
+    std::vector<std::shared_ptr<PySysLinkBase::InputPort>> inputPorts;
+    std::vector<std::shared_ptr<PySysLinkBase::OutputPort>> outputPorts;
+
+    // interpreter the python objects live in
+    std::shared_ptr<IPythonExecutor> executor;
+
+    // python objects
+    PyObject* pyModule = nullptr;
+    PyObject* pyClass = nullptr;
+    PyObject* pyInstance = nullptr;
+    PyObject* pyCompute = nullptr;
+    PyObject* pyComputeBatch = nullptr;
+    PyObject* pyUpdateConfiguration = nullptr;
+    PyObject* pyInputs = nullptr;
+    PyObject* pyTime = nullptr;
+    NativeKernel nativeKernel;
+    std::vector<PyObject*> pyPortViews; // per input port views, array signals in list exchange only
+
+    // per-step input/output storage, viewed from python without copies in buffer exchange mode
+    PortBuffer<Element, FixedInputs> inputBuffer;
+    PortBuffer<Element, FixedOutputs> outputBuffer;
+    PyObject* pyInputView = nullptr;
+    PyObject* pyOutputView = nullptr;
+
+    // ComputeBatch() arguments viewed by compute_batch(), reused across batches
+    std::vector<double> batchTimes;
+    std::vector<Element> batchInputs;
+    bool batchExportLogged = false;
+
+    // typed handles to the input port values, mutable since reading an input may re-resolve its handle
+    mutable PortBuffer<TypedSignalHandle<T>, FixedInputs> inputSignals;
+    // values last published to the output ports, refilled and handed to SetValue every step
+    PortBuffer<std::shared_ptr<PySysLinkBase::SignalValue<T>>, FixedOutputs> outputValues;
+    // staging for array outputs, keeps its capacity across steps
+    T outputPayload{};
+
+    unsigned long long argumentAllocationCount = 0;
+    unsigned long long objectAllocationCount = 0;
+    unsigned long long configurationUpdateCount = 0;
+
+    // memoization and minor step skipping
+    Purity purity = Purity::None;
+    PortBuffer<Element, FixedInputs> memoInputs;
+    double memoTime = 0.0;
+    bool hasMemoOutputs = false;      // output ports hold the outputs for memoInputs/memoTime
+    bool hasMajorStepOutputs = false; // output ports hold the outputs of a major step
+    unsigned long long memoHitCount = 0;
+    unsigned long long memoMissCount = 0;
+    unsigned long long minorStepHoldCount = 0;
+
+    // I/O trace, at most one of writer and reader depending on traceMode
+    TraceMode traceMode = TraceMode::Off;
+    std::string tracePath;
+    bool traceMismatchError = false;
+    bool traceMissLogged = false;
+    std::unique_ptr<BlockTraceWriter> traceWriter;
+    std::unique_ptr<BlockTraceReader> traceReader;
+
+    // lookup-table surrogate of compute(), null unless built
+    std::unique_ptr<LookupTableSurrogate> surrogate;
+    int surrogateCheckPoints = 0;
+    double surrogateTolerance = std::numeric_limits<double>::infinity();
+    unsigned long long surrogateHitCount = 0;
+    unsigned long long surrogateMissCount = 0;
+
+    // fused group membership, outputBuffer holds the chain's outputs for fusedInputs/fusedTime while hasFusedOutputs
+    std::shared_ptr<FusedBlockGroup> fusedGroup;
+    PortBuffer<Element, FixedInputs> fusedInputs;
+    double fusedTime = 0.0;
+    bool hasFusedOutputs = false;
+    unsigned long long fusedHitCount = 0;
+    unsigned long long fusedMissCount = 0;
+
+    // BlockCheckpointRecord::flags
+    static constexpr uint32_t CheckpointMemoOutputs = 1u << 0;
+    static constexpr uint32_t CheckpointMajorStepOutputs = 1u << 1;
+    static constexpr uint32_t CheckpointConstantOutputs = 1u << 2;
+    bool checkpointStored = false; // the time-triggered checkpoint already has this block's record
+
+    // per-phase timings, null when instrumentation is disabled
+    std::shared_ptr<BlockInstrumentation> instrumentation;
+    bool timingStep = false;
+    BlockInstrumentation::Clock::time_point phaseStart;
+    uint64_t portReadNanoseconds = 0;
+
+    // python heap sampling, unresolved unless memory tracking is enabled
+    PythonMemoryProbe memoryProbe;
+    uint32_t memorySampleInterval = 0;
+    uint32_t callsSinceMemorySample = 0;
+
+protected:
+    // One compute() call from inputBuffer to outputBuffer. Caller holds the GIL.
+    void ComputeStep(double currentTime)
+    {
+        if (nativeKernel.IsResolved())
+        {
+            ComputeNative(currentTime);
+        }
+        else if (bufferPortExchange)
+        {
+            ComputeWithBuffers(currentTime);
+        }
+        else
+        {
+            ComputeWithList(currentTime);
+        }
+    }
+
+    // The inputs as compute() receives them, refreshed from inputBuffer: the read-only view
+    // in buffer exchange mode, the reused inputs list otherwise. Borrowed reference, caller holds the GIL.
+    PyObject* InputsArgument()
+    {
+        if (bufferPortExchange)
+        {
+            return pyInputView;
+        }
+
+        // Reuse the preallocated inputs list unless python code kept a reference to it
+        if (Py_REFCNT(pyInputs) != 1)
+        {
+            Py_DECREF(pyInputs);
+            pyInputs = NewInputsList();
+            ++argumentAllocationCount;
+            ++objectAllocationCount;
+        }
+
+        // array ports are already in the list as views of inputBuffer
+        if constexpr (!SignalTraits<T>::IsArray)
+        {
+            for (size_t i = 0; i < InputCount(); ++i)
+            {
+                // the previous float or complex is refilled unless python kept a reference to it
+                if (RefillPyObject<T>(PyList_GET_ITEM(pyInputs, (Py_ssize_t)i), inputBuffer[i])) continue;
+                PyObject* pyv = ToPyObject<T>(inputBuffer[i]);
+                PyList_SetItem(pyInputs, (Py_ssize_t)i, pyv); // steals reference, releases previous item
+                ++objectAllocationCount;
+            }
+        }
+        return pyInputs;
+    }
+
+    // The time argument of compute(), refilled like the inputs. Borrowed reference, caller holds the GIL.
+    PyObject* TimeArgument(double currentTime)
+    {
+        if (!pyTime || !RefillPyObject<double>(pyTime, currentTime))
+        {
+            Py_XDECREF(pyTime);
+            pyTime = PyFloat_FromDouble(currentTime);
+            ++objectAllocationCount;
+        }
+        return pyTime;
+    }
+
+    // List exchange: inputs boxed into the reused list, outputs read back from the returned sequence.
+    void ComputeWithList(double currentTime)
+    {
+        PyObject* inputs = InputsArgument();
+
         // call compute(inputs, currentTime)
-        PyObject* pyResult = PyObject_CallMethod(pyInstance, "compute", "(Od)", pyInputs, currentTime);
-        Py_DECREF(pyInputs);
+        PyObject* args[2] = {inputs, TimeArgument(currentTime)};
+        RecordPhase(BridgePhase::InputMarshalling, portReadNanoseconds);
+        PyObject* pyResult = CallCompute(args, 2);
+        RecordPhase(BridgePhase::Compute);
 
         if (!pyResult)
         {
             // fetch python error as string for better diagnostics (non-fatal here -> throw)
             PyErr_Print();
-            PyGILState_Release(gstate);
             throw std::runtime_error("SimulationBlockPython: python compute() call failed");
         }
 
-        // Accept any iterable: try to convert to sequence/list
+        // Accept any iterable: try to convert to sequence/list, a list or tuple is used as is
+        if (!PyList_Check(pyResult) && !PyTuple_Check(pyResult)) ++objectAllocationCount;
         PyObject* seq = PySequence_Fast(pyResult, "python compute() must return a sequence");
         if (!seq)
         {
             Py_DECREF(pyResult);
-            PyGILState_Release(gstate);
             throw std::runtime_error("SimulationBlockPython: compute() did not return a sequence");
         }
 
         Py_ssize_t outCount = PySequence_Fast_GET_SIZE(seq);
-        if ((size_t)outCount < outputPorts.size())
+        if ((size_t)outCount < OutputCount())
         {
             Py_DECREF(seq);
             Py_DECREF(pyResult);
-            PyGILState_Release(gstate);
             throw std::runtime_error("SimulationBlockPython: compute() returned fewer outputs than NumOutputs");
         }
 
-        for (size_t i = 0; i < outputPorts.size(); ++i)
+        try
+        {
+            for (size_t i = 0; i < OutputCount(); ++i)
+            {
+                PyObject* item = PySequence_Fast_GET_ITEM(seq, (Py_ssize_t)i); // borrowed reference
+                ReadOutputItem(item, outputBuffer.data() + i * signalWidth);
+            }
+        }
+        catch (...)
         {
-            PyObject* item = PySequence_Fast_GET_ITEM(seq, (Py_ssize_t)i); // borrowed reference
-            T val = FromPyObject<T>(item);
-            std::shared_ptr<PySysLinkBase::UnknownTypeSignalValue> outputValue = this->outputPorts[i]->GetValue();
-            auto outputValueSignal = outputValue->TryCastToTyped<T>();
-            outputValueSignal->SetPayload(val);
-            this->outputPorts[i]->SetValue(std::make_shared<PySysLinkBase::SignalValue<T>>(*outputValueSignal));
+            Py_DECREF(seq);
+            Py_DECREF(pyResult);
+            throw;
         }
 
         Py_DECREF(seq);
         Py_DECREF(pyResult);
+        RecordPhase(BridgePhase::OutputUnmarshalling);
+    }
 
-        PyGILState_Release(gstate);
-        return outputPorts;
+    // Native kernel on inputBuffer and outputBuffer, needs no GIL
+    void ComputeNative(double currentTime)
+    {
+        RecordPhase(BridgePhase::InputMarshalling, portReadNanoseconds);
+        nativeKernel.Call<Element>(inputBuffer.data(), inputBuffer.size(), outputBuffer.data(), outputBuffer.size(), currentTime);
+        RecordPhase(BridgePhase::Compute);
+    }
+
+    // Buffer exchange: inputBuffer exposed as a read-only memoryview,
+    // python fills the writable outputs memoryview in place.
+    void ComputeWithBuffers(double currentTime)
+    {
+        // call compute(inputs, outputs, currentTime)
+        PyObject* args[3] = {pyInputView, pyOutputView, TimeArgument(currentTime)};
+        RecordPhase(BridgePhase::InputMarshalling, portReadNanoseconds);
+        PyObject* pyResult = CallCompute(args, 3);
+        RecordPhase(BridgePhase::Compute);
+
+        if (!pyResult)
+        {
+            PyErr_Print();
+            throw std::runtime_error("SimulationBlockPython: python compute() call failed");
+        }
+        Py_DECREF(pyResult);
+        RecordPhase(BridgePhase::OutputUnmarshalling);
+    }
+
+    // compute_batch(times, inputs) -> steps x NumOutputs (x SignalShape), either as a C-contiguous buffer of Element
+    // (e.g. a numpy array) or as a sequence of per-step sequences. Caller holds the GIL.
+    void ComputeBatchWithPython(const std::vector<double>& times, const std::vector<Element>& inputs, std::vector<Element>& outputs)
+    {
+        Py_ssize_t steps = (Py_ssize_t)times.size();
+        std::vector<Py_ssize_t> batchShape = PortsShape((Py_ssize_t)inputPorts.size());
+        batchShape.insert(batchShape.begin(), steps);
+        // block-owned copies, so an export python keeps past the call never points into the caller's vectors
+        batchTimes.assign(times.begin(), times.end());
+        batchInputs.assign(inputs.begin(), inputs.end());
+        PyObject* pyTimes = ToPyMemoryView<double>(batchTimes.data(), steps, true);
+        PyObject* pyBatchInputs = ToPyMemoryView<Element>(batchInputs.data(), batchShape, true);
+        PyObject* args[2] = {pyTimes, pyBatchInputs};
+#if PY_VERSION_HEX >= 0x03090000
+        PyObject* pyResult = PyObject_Vectorcall(pyComputeBatch, args, 2, nullptr);
+#else
+        PyObject* pyResult = PyObject_CallFunctionObjArgs(pyComputeBatch, args[0], args[1], NULL);
+#endif
+        // the views are only valid during the call; release() fails (BufferError) while python still
+        // holds an export of them, e.g. a numpy array, which then sees the next batch's values
+        bool released = true;
+        for (PyObject* view : {pyBatchInputs, pyTimes})
+        {
+            PyObject* pyReleased = PyObject_CallMethod(view, "release", nullptr);
+            if (!pyReleased)
+            {
+                released = false;
+                PyErr_Clear();
+            }
+            Py_XDECREF(pyReleased);
+        }
+        if (!released && !batchExportLogged)
+        {
+            batchExportLogged = true;
+            spdlog::warn("SimulationBlockPython: compute_batch() of {} keeps an array over its times/inputs views, "
+                         "copy them to keep values: the storage is reused by the next batch", className);
+        }
+        Py_DECREF(pyBatchInputs);
+        Py_DECREF(pyTimes);
+
+        if (!pyResult)
+        {
+            PyErr_Print();
+            throw std::runtime_error("SimulationBlockPython: python compute_batch() call failed");
+        }
+
+        if (CopyFromPyBuffer<Element>(pyResult, outputs.data(), outputs.size()))
+        {
+            Py_DECREF(pyResult);
+            return;
+        }
+
+        PyObject* rows = PySequence_Fast(pyResult, "python compute_batch() must return a sequence");
+        Py_DECREF(pyResult);
+        if (!rows)
+        {
+            throw std::runtime_error("SimulationBlockPython: compute_batch() did not return a sequence");
+        }
+        if (PySequence_Fast_GET_SIZE(rows) < steps)
+        {
+            Py_DECREF(rows);
+            throw std::runtime_error("SimulationBlockPython: compute_batch() returned fewer rows than steps");
+        }
+
+        for (Py_ssize_t k = 0; k < steps; ++k)
+        {
+            PyObject* row = PySequence_Fast(PySequence_Fast_GET_ITEM(rows, k), "python compute_batch() rows must be sequences");
+            if (!row || (size_t)PySequence_Fast_GET_SIZE(row) < outputPorts.size())
+            {
+                Py_XDECREF(row);
+                Py_DECREF(rows);
+                throw std::runtime_error("SimulationBlockPython: compute_batch() returned a row with fewer outputs than NumOutputs");
+            }
+            try
+            {
+                for (size_t i = 0; i < outputPorts.size(); ++i)
+                {
+                    ReadOutputItem(PySequence_Fast_GET_ITEM(row, (Py_ssize_t)i), outputs.data() + (k * outputPorts.size() + i) * signalWidth);
+                }
+            }
+            catch (...)
+            {
+                Py_DECREF(row);
+                Py_DECREF(rows);
+                throw;
+            }
+            Py_DECREF(row);
+        }
+        Py_DECREF(rows);
+    }
+
+    PyObject* CallCompute(PyObject* const* args, size_t nargs)
+    {
+#if PY_VERSION_HEX >= 0x03090000
+        return PyObject_Vectorcall(pyCompute, args, nargs, nullptr);
+#else
+        PyObject* pyArgs = PyTuple_New((Py_ssize_t)nargs);
+        for (size_t i = 0; i < nargs; ++i)
+        {
+            Py_INCREF(args[i]);
+            PyTuple_SET_ITEM(pyArgs, (Py_ssize_t)i, args[i]);
+        }
+        PyObject* pyResult = PyObject_Call(pyCompute, pyArgs, nullptr);
+        Py_DECREF(pyArgs);
+        return pyResult;
+#endif
+    }
+
+    // pure = True / "inputs" / "inputs_and_time", anything else falsy means not pure
+    Purity ParsePurity(PyObject* pyPure) const
+    {
+        if (pyPure && PyUnicode_Check(pyPure))
+        {
+            const char* value = PyUnicode_AsUTF8(pyPure);
+            std::string declared = value ? value : "";
+            if (declared == "inputs") return Purity::InputsOnly;
+            if (declared == "inputs_and_time") return Purity::InputsAndTime;
+            spdlog::warn("SimulationBlockPython: {} declares unknown pure = \"{}\", outputs will not be memoized", className, declared);
+            return Purity::None;
+        }
+        int truth = pyPure ? PyObject_IsTrue(pyPure) : 0;
+        if (truth < 0)
+        {
+            PyErr_Clear();
+            truth = 0;
+        }
+        return truth ? Purity::InputsOnly : Purity::None;
+    }
+
+    // Continuous or discrete, whichever the engine resolves from the connected blocks
+    static std::shared_ptr<PySysLinkBase::SampleTime> InheritedSampleTime()
+    {
+        std::vector<PySysLinkBase::SampleTimeType> supportedSampleTimeTypes = {};
+        supportedSampleTimeTypes.push_back(PySysLinkBase::SampleTimeType::continuous);
+        supportedSampleTimeTypes.push_back(PySysLinkBase::SampleTimeType::discrete);
+        return std::make_shared<PySysLinkBase::SampleTime>(PySysLinkBase::SampleTimeType::inherited, supportedSampleTimeTypes);
+    }
+
+    // sample_time = period / (period, offset) / 0 / inf / -1 / None, or the names "continuous", "constant", "inherited".
+    // Anything unusable is warned about and leaves the inherited sample time. Caller holds the GIL.
+    void ParseSampleTime(PyObject* pyDeclared)
+    {
+        if (pyDeclared == Py_None) return;
+
+        double period = -1.0;
+        double offset = 0.0;
+        if (PyUnicode_Check(pyDeclared))
+        {
+            const char* value = PyUnicode_AsUTF8(pyDeclared);
+            std::string declared = value ? value : "";
+            if (declared == "continuous") period = 0.0;
+            else if (declared == "constant") period = std::numeric_limits<double>::infinity();
+            else if (declared != "inherited")
+            {
+                spdlog::warn("SimulationBlockPython: {} declares unknown sample_time = \"{}\", the sample time stays inherited", className, declared);
+                return;
+            }
+        }
+        else if ((PyTuple_Check(pyDeclared) || PyList_Check(pyDeclared)) && PySequence_Size(pyDeclared) == 2)
+        {
+            PyObject* pyPeriod = PySequence_GetItem(pyDeclared, 0);
+            PyObject* pyOffset = PySequence_GetItem(pyDeclared, 1);
+            period = PyFloat_AsDouble(pyPeriod);
+            offset = PyFloat_AsDouble(pyOffset);
+            Py_DECREF(pyPeriod);
+            Py_DECREF(pyOffset);
+        }
+        else
+        {
+            period = PyFloat_AsDouble(pyDeclared);
+        }
+        if (PyErr_Occurred())
+        {
+            PyErr_Clear();
+            spdlog::warn("SimulationBlockPython: {} declares a sample_time that is not a number or (period, offset), the sample time stays inherited", className);
+            return;
+        }
+
+        if (period == -1.0) return;
+        if (offset != 0.0)
+        {
+            spdlog::warn("SimulationBlockPython: {} declares a sample time offset of {:g}, discrete sample times have no offset, ignored", className, offset);
+        }
+
+        if (period == 0.0)
+        {
+            declaredSampleTimeType = PySysLinkBase::SampleTimeType::continuous;
+            this->sampleTime = std::make_shared<PySysLinkBase::SampleTime>(PySysLinkBase::SampleTimeType::continuous);
+        }
+        else if (std::isinf(period) && period > 0.0)
+        {
+            declaredSampleTimeType = PySysLinkBase::SampleTimeType::constant;
+            this->sampleTime = std::make_shared<PySysLinkBase::SampleTime>(PySysLinkBase::SampleTimeType::constant);
+        }
+        else if (period > 0.0 && std::isfinite(period))
+        {
+            declaredSampleTimeType = PySysLinkBase::SampleTimeType::discrete;
+            this->sampleTime = std::make_shared<PySysLinkBase::SampleTime>(PySysLinkBase::SampleTimeType::discrete, period);
+        }
+        else
+        {
+            spdlog::warn("SimulationBlockPython: {} declares an invalid sample_time period of {:g}, the sample time stays inherited", className, period);
+        }
+    }
+
+    // Port counts, compile-time constants in fixed port count specializations
+    size_t InputCount() const
+    {
+        if constexpr (FixedInputs != DynamicPortCount) return FixedInputs;
+        else return inputPorts.size();
+    }
+
+    size_t OutputCount() const
+    {
+        if constexpr (FixedOutputs != DynamicPortCount) return FixedOutputs;
+        else return outputPorts.size();
+    }
+
+    T InitialPayload() const
+    {
+        if constexpr (SignalTraits<T>::IsArray)
+        {
+            return T(signalWidth, Element(0.0));
+        }
+        else
+        {
+            return T(0.0);
+        }
+    }
+
+    // Shape of a buffer holding ports payloads: (ports) or (ports, *SignalShape)
+    std::vector<Py_ssize_t> PortsShape(Py_ssize_t ports) const
+    {
+        std::vector<Py_ssize_t> shape = {ports};
+        shape.insert(shape.end(), signalShape.begin(), signalShape.end());
+        return shape;
+    }
+
+    PyObject* NewInputsList() const
+    {
+        PyObject* list = PyList_New((Py_ssize_t)inputPorts.size());
+        for (size_t i = 0; i < inputPorts.size(); ++i)
+        {
+            PyObject* item = pyPortViews.empty() ? Py_None : pyPortViews[i];
+            Py_INCREF(item);
+            PyList_SET_ITEM(list, (Py_ssize_t)i, item);
+        }
+        return list;
+    }
+
+    // Converts one output port value returned by python into signalWidth elements at dest
+    void ReadOutputItem(PyObject* item, Element* dest) const
+    {
+        if constexpr (SignalTraits<T>::IsArray)
+        {
+            if (CopyFromPyBuffer<Element>(item, dest, signalWidth))
+            {
+                return;
+            }
+            T value = FromPyObject<T>(item);
+            if (value.size() != signalWidth)
+            {
+                throw std::runtime_error("SimulationBlockPython: compute() returned an output with " + std::to_string(value.size()) +
+                                         " elements, SignalShape has " + std::to_string(signalWidth));
+            }
+            std::copy(value.begin(), value.end(), dest);
+        }
+        else
+        {
+            *dest = FromPyObject<T>(item);
+        }
+    }
+
+    // Samples compute() into the lookup table, leaves surrogate null if the block does not qualify
+    void BuildSurrogate(std::unique_ptr<LookupTableSurrogate> table, int checkPoints, double tolerance)
+    {
+        if constexpr (!std::is_same_v<T, double>)
+        {
+            spdlog::warn("SimulationBlockPython: Surrogate Table needs Double signals, {} keeps calling compute()", className);
+        }
+        else
+        {
+            if (purity != Purity::InputsOnly)
+            {
+                spdlog::warn("SimulationBlockPython: Surrogate Table needs pure = \"inputs\", {} keeps calling compute()", className);
+                return;
+            }
+
+            // t is irrelevant to a block whose outputs depend on the inputs only
+            auto sample = [this](const double* in, double* out) {
+                std::copy(in, in + InputCount(), inputBuffer.data());
+                ComputeStep(0.0);
+                std::copy(outputBuffer.data(), outputBuffer.data() + OutputCount(), out);
+            };
+
+            auto start = std::chrono::steady_clock::now();
+            double maxError = 0.0;
+            executor->Execute([&] {
+                table->Build(sample);
+                if (checkPoints > 0)
+                {
+                    maxError = table->MaxError(sample, static_cast<size_t>(checkPoints));
+                }
+            });
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            if (checkPoints > 0)
+            {
+                if (maxError > tolerance)
+                {
+                    spdlog::warn("SimulationBlockPython: {} surrogate is off by up to {:g} (tolerance {:g}) at {} random points, keeps calling compute()",
+                                 className, maxError, tolerance, checkPoints);
+                    return;
+                }
+                spdlog::info("SimulationBlockPython: {} surrogate is off by up to {:g} at {} random points", className, maxError, checkPoints);
+            }
+            spdlog::info("SimulationBlockPython: {} replaced by a {} point lookup table sampled in {:.1f} ms",
+                         className, table->GetSampleCount(), 1e3 * seconds);
+            surrogate = std::move(table);
+        }
+    }
+
+    // True if outputBuffer holds the outputs the group's chain computed for this t and these inputs
+    bool TakeFusedOutputs(double currentTime)
+    {
+        if (!hasFusedOutputs) return false;
+        hasFusedOutputs = false;
+        if (currentTime != fusedTime ||
+            std::memcmp(inputBuffer.data(), fusedInputs.data(), inputBuffer.size() * sizeof(Element)) != 0)
+        {
+            ++fusedMissCount;
+            return false;
+        }
+        ++fusedHitCount;
+        return true;
     }
 
-    // Minimal config update support (no dynamic changes)
-    bool _TryUpdateConfigurationValue(std::string /*keyName*/, PySysLinkBase::ConfigurationValue /*value*/) override
+    // Fills outputBuffer from the surrogate, false if the inputs are outside its ranges
+    bool EvaluateSurrogate()
     {
+        if constexpr (std::is_same_v<T, double>)
+        {
+            if (surrogate->Evaluate(inputBuffer.data(), outputBuffer.data()))
+            {
+                ++surrogateHitCount;
+                return true;
+            }
+        }
+        ++surrogateMissCount;
         return false;
     }
 
-private:
-    // configuration
-    std::string moduleName;
-    std::string className;
-    int numInputs = 1;
-    int numOutputs = 1;
+    // Puts the python state, output ports and memoization state back as recorded
+    void RestoreCheckpoint(const BlockCheckpointRecord& record)
+    {
+        if (record.elementFormat != BufferFormat<Element>() || record.elementSize != sizeof(Element) ||
+            record.inputCount != inputBuffer.size() || record.outputCount != outputBuffer.size() ||
+            record.inputs.size() != inputBuffer.size() * sizeof(Element) || record.outputs.size() != outputBuffer.size() * sizeof(Element))
+        {
+            throw std::runtime_error("SimulationBlockPython: checkpoint of " + record.blockId + " was recorded with another signal type or port layout");
+        }
 
-    // ports and sample time
-    std::shared_ptr<PySysLinkBase::SampleTime> sampleTime;
-    std::vector<std::shared_ptr<PySysLinkBase::InputPort>> inputPorts;
-    std::vector<std::shared_ptr<PySysLinkBase::OutputPort>> outputPorts;
+        executor->Execute([&] {
+            UnpicklePythonState(pyInstance, record.pythonState);
+        });
 
-    // python objects
-    PyObject* pyModule = nullptr;
-    PyObject* pyClass = nullptr;
-    PyObject* pyInstance = nullptr;
+        std::memcpy(inputBuffer.data(), record.inputs.data(), record.inputs.size());
+        memoInputs = inputBuffer;
+        memoTime = record.memoTime;
+        std::memcpy(outputBuffer.data(), record.outputs.data(), record.outputs.size());
+        for (size_t i = 0; i < OutputCount(); ++i)
+        {
+            WriteOutput(i, outputBuffer.data() + i * signalWidth);
+        }
+        hasMemoOutputs = (record.flags & CheckpointMemoOutputs) != 0;
+        hasMajorStepOutputs = (record.flags & CheckpointMajorStepOutputs) != 0;
+        hasConstantOutputs = (record.flags & CheckpointConstantOutputs) != 0;
+        spdlog::debug("SimulationBlockPython: {} restored from its checkpoint at t = {:g}", record.blockId, record.time);
+    }
 
-private:
-    // Helper: call optional no-arg method on instance
-    void CallOptionalVoidMethod(const char* methodName)
+    // Fills outputBuffer from the trace in replay mode, false if the call has to be computed
+    bool ReplayStep(double currentTime)
+    {
+        if (!traceReader) return false;
+        if (traceReader->Next(currentTime, inputBuffer.data(), outputBuffer.data())) return true;
+
+        if (traceMismatchError)
+        {
+            throw std::runtime_error("SimulationBlockPython: no recorded call at t = " + std::to_string(currentTime) +
+                                     " with these inputs in " + tracePath);
+        }
+        if (!traceMissLogged)
+        {
+            spdlog::warn("SimulationBlockPython: {} diverged from {} at t = {}, computing calls missing from the trace",
+                         className, tracePath, currentTime);
+            traceMissLogged = true;
+        }
+        return false;
+    }
+
+    void ReadInput(size_t i, Element* dest) const
     {
-        PyGILState_STATE gstate = PyGILState_Ensure();
-        if (pyInstance && PyObject_HasAttrString(pyInstance, methodName))
+        auto inputValueSignal = inputSignals[i].Resolve(this->inputPorts[i]->GetValue());
+        if constexpr (SignalTraits<T>::IsArray)
+        {
+            const T& payload = inputValueSignal->GetPayload();
+            if (payload.size() != signalWidth)
+            {
+                throw std::runtime_error("SimulationBlockPython: input " + std::to_string(i) + " has " + std::to_string(payload.size()) +
+                                         " elements, SignalShape has " + std::to_string(signalWidth));
+            }
+            std::copy(payload.begin(), payload.end(), dest);
+        }
+        else
         {
-            PyObject* res = PyObject_CallMethod(pyInstance, const_cast<char*>(methodName), nullptr);
-            Py_XDECREF(res);
+            *dest = inputValueSignal->GetPayload();
         }
-        PyGILState_Release(gstate);
+    }
+
+    void ReadOutput(size_t i, Element* dest) const
+    {
+        if constexpr (SignalTraits<T>::IsArray)
+        {
+            const T& payload = outputValues[i]->GetPayload();
+            std::copy(payload.begin(), payload.begin() + std::min(payload.size(), signalWidth), dest);
+        }
+        else
+        {
+            *dest = outputValues[i]->GetPayload();
+        }
+    }
+
+    void WriteOutput(size_t i, const Element* src)
+    {
+        // the port may hand out copies of what it holds, so results always go through SetValue;
+        // the published value is reused, which saves the allocation and cast the old copy needed
+        if constexpr (SignalTraits<T>::IsArray)
+        {
+            // SetPayload takes the payload by value, so array signals still copy it once per step
+            outputPayload.assign(src, src + signalWidth);
+            outputValues[i]->SetPayload(outputPayload);
+        }
+        else
+        {
+            outputValues[i]->SetPayload(*src);
+        }
+        this->outputPorts[i]->SetValue(outputValues[i]);
+    }
+
+    // Instrumentation helpers, no-ops unless instrumentation is enabled and a step is being timed.
+    // Each phase runs from the end of the previous one.
+    uint64_t EndPhase()
+    {
+        if (!timingStep) return 0;
+        auto now = BlockInstrumentation::Clock::now();
+        uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - phaseStart).count());
+        phaseStart = now;
+        return elapsed;
+    }
+
+    void RecordPhase(BridgePhase phase, uint64_t extraNanoseconds = 0)
+    {
+        if (!timingStep) return;
+        instrumentation->Record(phase, EndPhase() + extraNanoseconds);
+    }
+
+    // Drops every python reference the block holds. Caller holds the GIL.
+    void ReleasePythonObjects()
+    {
+        Py_CLEAR(pyInputView);
+        Py_CLEAR(pyOutputView);
+        Py_CLEAR(pyInputs);
+        Py_CLEAR(pyTime);
+        for (PyObject* view : pyPortViews)
+        {
+            Py_DECREF(view);
+        }
+        pyPortViews.clear();
+        nativeKernel.Release();
+        memoryProbe.Release();
+        Py_CLEAR(pyUpdateConfiguration);
+        Py_CLEAR(pyComputeBatch);
+        Py_CLEAR(pyCompute);
+        Py_CLEAR(pyInstance);
+        Py_CLEAR(pyClass);
+        Py_CLEAR(pyModule);
+    }
+
+    // Helper: call optional no-arg method on instance
+    void CallOptionalVoidMethod(const char* methodName)
+    {
+        executor->Execute([this, methodName] {
+            if (pyInstance && PyObject_HasAttrString(pyInstance, methodName))
+            {
+                PyObject* res = PyObject_CallMethod(pyInstance, const_cast<char*>(methodName), nullptr);
+                Py_XDECREF(res);
+            }
+        });
     }
 };
 
@@ -0,0 +1,263 @@
+#ifndef SRC_PYTHON_SIMULATION_BLOCK_CONTINUOUS_H
+#define SRC_PYTHON_SIMULATION_BLOCK_CONTINUOUS_H
+
+#pragma once
+
+#include <Python.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include <PySysLinkBase/ISimulationBlockWithContinuousStates.h>
+
+#include "SimulationBlockPython.h"
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+/*
+ * SimulationBlockPython whose states are integrated by the host solver.
+ *
+ * Created by BlockFactoryPython when the python class defines derivatives():
+ *   class MyBlock:
+ *       def get_states(self) -> list:
+ *           # current state vector x, its length fixes the number of states
+ *       def set_states(self, x: memoryview) -> None:
+ *           # x is read-only and reused, copy what you keep
+ *       def derivatives(self, t: float, x: memoryview, u) -> list:
+ *           # dx/dt at (t, x) as a sequence or buffer of floats;
+ *           # u has the same form as the inputs of compute()
+ *       def jacobian(self, t: float, x: memoryview, u) -> list:
+ *           # optional, d(dx/dt)/dx as a list of rows
+ *
+ * compute() still produces the outputs, from the states last passed to set_states().
+ * x and dx/dt travel as one contiguous buffer each per call instead of one object per state.
+ */
+template <typename T>
+class SimulationBlockPythonContinuous : public SimulationBlockPython<T, PySysLinkBase::ISimulationBlockWithContinuousStates>
+{
+    using Base = SimulationBlockPython<T, PySysLinkBase::ISimulationBlockWithContinuousStates>;
+
+public:
+    SimulationBlockPythonContinuous(std::map<std::string, PySysLinkBase::ConfigurationValue> blockConfiguration,
+                                    std::shared_ptr<PySysLinkBase::IBlockEventsHandler> eventsHandler,
+                                    std::shared_ptr<IPythonExecutor> executor = MainInterpreterExecutor::Instance(),
+                                    std::shared_ptr<PythonClassCache> classCache = nullptr,
+                                    std::shared_ptr<ConfigurationMappingCache> configurationCache = nullptr)
+        : Base(blockConfiguration, eventsHandler, executor, classCache, configurationCache)
+    {
+        if (this->declaredSampleTimeType == PySysLinkBase::SampleTimeType::discrete ||
+            this->declaredSampleTimeType == PySysLinkBase::SampleTimeType::constant)
+        {
+            spdlog::warn("SimulationBlockPythonContinuous: {} has continuous states, ignoring its sample_time declaration", this->className);
+            this->declaredSampleTimeType = PySysLinkBase::SampleTimeType::inherited;
+            this->sampleTime = Base::InheritedSampleTime();
+        }
+
+        this->executor->Execute([&] {
+            pyGetStates = GetRequiredMethod("get_states");
+            pySetStates = GetRequiredMethod("set_states");
+            pyDerivatives = GetRequiredMethod("derivatives");
+            if (PyObject_HasAttrString(this->pyInstance, "jacobian"))
+            {
+                pyJacobian = PyObject_GetAttrString(this->pyInstance, "jacobian");
+                if (pyJacobian && !PyCallable_Check(pyJacobian))
+                {
+                    Py_CLEAR(pyJacobian);
+                }
+            }
+
+            // the number of states is fixed from here on, so the view never dangles
+            PyObject* pyStates = PyObject_CallFunctionObjArgs(pyGetStates, NULL);
+            if (!pyStates)
+            {
+                PyErr_Print();
+                ReleasePythonObjects();
+                throw std::runtime_error("SimulationBlockPythonContinuous: get_states() failed on: " + this->className);
+            }
+            try {
+                stateBuffer = FromPyObject<std::vector<double>>(pyStates);
+            } catch (...) {
+                Py_DECREF(pyStates);
+                ReleasePythonObjects();
+                throw;
+            }
+            Py_DECREF(pyStates);
+
+            pyStateView = ToPyMemoryView<double>(stateBuffer.data(), (Py_ssize_t)stateBuffer.size(), true);
+        });
+    }
+
+    ~SimulationBlockPythonContinuous()
+    {
+        this->executor->Execute([this] { ReleasePythonObjects(); });
+    }
+
+    const std::vector<double> GetContinuousStates() override
+    {
+        this->executor->Execute([this] {
+            PyObject* pyStates = PyObject_CallFunctionObjArgs(pyGetStates, NULL);
+            if (!pyStates)
+            {
+                PyErr_Print();
+                throw std::runtime_error("SimulationBlockPythonContinuous: python get_states() call failed");
+            }
+            ReadStateVector(pyStates, stateBuffer.data(), "get_states()");
+        });
+        return stateBuffer;
+    }
+
+    void SetContinuousStates(std::vector<double> newStates) override
+    {
+        if (newStates.size() != stateBuffer.size())
+        {
+            throw std::invalid_argument("SimulationBlockPythonContinuous: expected " + std::to_string(stateBuffer.size()) +
+                                        " states, got " + std::to_string(newStates.size()));
+        }
+        std::copy(newStates.begin(), newStates.end(), stateBuffer.begin());
+
+        this->executor->Execute([this] {
+            PyObject* pyResult = PyObject_CallFunctionObjArgs(pySetStates, pyStateView, NULL);
+            if (!pyResult)
+            {
+                PyErr_Print();
+                throw std::runtime_error("SimulationBlockPythonContinuous: python set_states() call failed");
+            }
+            Py_DECREF(pyResult);
+        });
+    }
+
+    // derivatives(t, x, u) at the states last set and the current inputs
+    const std::vector<double> GetContinuousStateDerivatives(std::shared_ptr<PySysLinkBase::SampleTime> /*sampleTime*/, double currentTime) override
+    {
+        ReadInputs();
+
+        std::vector<double> derivatives(stateBuffer.size());
+        this->executor->Execute([&] {
+            PyObject* pyResult = CallWithStates(pyDerivatives, currentTime);
+            if (!pyResult)
+            {
+                PyErr_Print();
+                throw std::runtime_error("SimulationBlockPythonContinuous: python derivatives() call failed");
+            }
+            ReadStateVector(pyResult, derivatives.data(), "derivatives()");
+        });
+        return derivatives;
+    }
+
+    // jacobian(t, x, u) if the python class defines it, empty otherwise
+    const std::vector<std::vector<double>> GetContinuousStateJacobians(std::shared_ptr<PySysLinkBase::SampleTime> /*sampleTime*/, double currentTime) override
+    {
+        if (!pyJacobian)
+        {
+            return {};
+        }
+        ReadInputs();
+
+        std::vector<std::vector<double>> jacobian(stateBuffer.size(), std::vector<double>(stateBuffer.size()));
+        this->executor->Execute([&] {
+            PyObject* pyResult = CallWithStates(pyJacobian, currentTime);
+            if (!pyResult)
+            {
+                PyErr_Print();
+                throw std::runtime_error("SimulationBlockPythonContinuous: python jacobian() call failed");
+            }
+            std::vector<double> flat(stateBuffer.size() * stateBuffer.size());
+            ReadStateVector(pyResult, flat.data(), "jacobian()", flat.size());
+            for (size_t row = 0; row < stateBuffer.size(); ++row)
+            {
+                std::copy(flat.begin() + row * stateBuffer.size(), flat.begin() + (row + 1) * stateBuffer.size(), jacobian[row].begin());
+            }
+        });
+        return jacobian;
+    }
+
+    size_t GetStateCount() const
+    {
+        return stateBuffer.size();
+    }
+
+private:
+    PyObject* pyGetStates = nullptr;
+    PyObject* pySetStates = nullptr;
+    PyObject* pyDerivatives = nullptr;
+    PyObject* pyJacobian = nullptr;
+
+    // states last set by the solver (or read from python), viewed read-only from python
+    std::vector<double> stateBuffer;
+    PyObject* pyStateView = nullptr;
+
+    PyObject* GetRequiredMethod(const char* methodName)
+    {
+        PyObject* method = PyObject_GetAttrString(this->pyInstance, methodName);
+        if (!method || !PyCallable_Check(method))
+        {
+            Py_XDECREF(method);
+            PyErr_Clear();
+            ReleasePythonObjects();
+            throw std::runtime_error(std::string("SimulationBlockPythonContinuous: ") + methodName + "() not found or not callable on: " + this->className);
+        }
+        return method;
+    }
+
+    void ReleasePythonObjects()
+    {
+        Py_CLEAR(pyStateView);
+        Py_CLEAR(pyJacobian);
+        Py_CLEAR(pyDerivatives);
+        Py_CLEAR(pySetStates);
+        Py_CLEAR(pyGetStates);
+    }
+
+    void ReadInputs()
+    {
+        for (size_t i = 0; i < this->inputPorts.size(); ++i)
+        {
+            this->ReadInput(i, this->inputBuffer.data() + i * this->signalWidth);
+        }
+    }
+
+    // method(t, x, u), caller holds the GIL
+    PyObject* CallWithStates(PyObject* method, double currentTime)
+    {
+        PyObject* args[3] = {this->TimeArgument(currentTime), pyStateView, this->InputsArgument()};
+#if PY_VERSION_HEX >= 0x03090000
+        PyObject* pyResult = PyObject_Vectorcall(method, args, 3, nullptr);
+#else
+        PyObject* pyResult = PyObject_CallFunctionObjArgs(method, args[0], args[1], args[2], NULL);
+#endif
+        return pyResult;
+    }
+
+    // Copies count (default: number of states) floats out of a buffer or (nested) sequence, steals pyValue
+    void ReadStateVector(PyObject* pyValue, double* dest, const char* source, size_t count = 0)
+    {
+        if (count == 0) count = stateBuffer.size();
+        if (CopyFromPyBuffer<double>(pyValue, dest, count))
+        {
+            Py_DECREF(pyValue);
+            return;
+        }
+
+        std::vector<double> values;
+        try {
+            values = FromPyObject<std::vector<double>>(pyValue);
+        } catch (...) {
+            Py_DECREF(pyValue);
+            throw;
+        }
+        Py_DECREF(pyValue);
+        if (values.size() != count)
+        {
+            throw std::runtime_error(std::string("SimulationBlockPythonContinuous: ") + source + " returned " + std::to_string(values.size()) +
+                                     " values, expected " + std::to_string(count));
+        }
+        std::copy(values.begin(), values.end(), dest);
+    }
+};
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_PYTHON_SIMULATION_BLOCK_CONTINUOUS_H
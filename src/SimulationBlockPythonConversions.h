@@ -1,10 +1,114 @@
 #pragma once
 #include <Python.h>
+#include <cmath>
 #include <complex>
+#include <cstdint>
+#include <string>
+#include <type_traits>
 #include <stdexcept>
+#include <cstring>
+#include <vector>
 
 namespace BlockTypeSupports::BasicPythonSupport {
 
+// ---------- Signal layout ----------
+// Scalar payloads occupy one element of a port buffer,
+// vector payloads a fixed number of contiguous elements (see SignalShape).
+template<typename T>
+struct SignalTraits {
+    using Element = T;
+    static constexpr bool IsArray = false;
+};
+
+template<typename E>
+struct SignalTraits<std::vector<E>> {
+    using Element = E;
+    static constexpr bool IsArray = true;
+};
+
+// ---------- Buffer scalars ----------
+// Single value read through the buffer protocol, which NumPy scalars (numpy.float32, numpy.int64,
+// numpy.bool_, ...) export without numpy headers and without creating a python float first.
+struct BufferScalar {
+    enum class Kind { Real, Integer, Complex } kind = Kind::Real;
+    double real = 0.0;
+    double imag = 0.0;
+    long long integer = 0;
+};
+
+template<typename S>
+inline S ReadUnaligned(const void* p) {
+    S value;
+    std::memcpy(&value, p, sizeof(S));
+    return value;
+}
+
+// Returns false (with no python error set) unless obj exports exactly one number
+inline bool ReadBufferScalar(PyObject* obj, BufferScalar& value) {
+    if (!PyObject_CheckBuffer(obj) || PyBytes_Check(obj) || PyByteArray_Check(obj) || PyMemoryView_Check(obj)) return false;
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(obj, &view, PyBUF_FORMAT) != 0) {
+        PyErr_Clear();
+        return false;
+    }
+
+    const char* format = view.format ? view.format : "B";
+    const char nativeOrder = PY_LITTLE_ENDIAN ? '<' : '>';
+    if (*format == '@' || *format == '=' || *format == nativeOrder) ++format;
+    bool ok = view.len == view.itemsize;
+    if (ok) {
+        const void* p = view.buf;
+        std::string f = format;
+        using Kind = BufferScalar::Kind;
+        // the element size is checked rather than assumed: standard-size formats ('<', '=') and
+        // platforms differ from the native C types, e.g. for 'l'
+        if ((f == "d" || f == "Zd") && view.itemsize == (f == "d" ? 1 : 2) * (Py_ssize_t)sizeof(double)) {
+            value.kind = f == "d" ? Kind::Real : Kind::Complex;
+            value.real = ReadUnaligned<double>(p);
+            if (f == "Zd") value.imag = ReadUnaligned<double>(static_cast<const char*>(p) + sizeof(double));
+        }
+        else if ((f == "f" || f == "Zf") && view.itemsize == (f == "f" ? 1 : 2) * (Py_ssize_t)sizeof(float)) {
+            value.kind = f == "f" ? Kind::Real : Kind::Complex;
+            value.real = ReadUnaligned<float>(p);
+            if (f == "Zf") value.imag = ReadUnaligned<float>(static_cast<const char*>(p) + sizeof(float));
+        }
+        else if (f == "?" && view.itemsize == 1) { value.kind = Kind::Integer; value.integer = *static_cast<const unsigned char*>(p) ? 1 : 0; }
+        else if (f.size() == 1 && std::strchr("bhilq", f[0])) {
+            // signed integer of whatever size the exporter declares
+            value.kind = Kind::Integer;
+            switch (view.itemsize) {
+                case 1: value.integer = ReadUnaligned<int8_t>(p); break;
+                case 2: value.integer = ReadUnaligned<int16_t>(p); break;
+                case 4: value.integer = ReadUnaligned<int32_t>(p); break;
+                case 8: value.integer = ReadUnaligned<int64_t>(p); break;
+                default: ok = false;
+            }
+        }
+        else if (f.size() == 1 && std::strchr("BHILQ", f[0])) {
+            value.kind = Kind::Integer;
+            switch (view.itemsize) {
+                case 1: value.integer = ReadUnaligned<uint8_t>(p); break;
+                case 2: value.integer = ReadUnaligned<uint16_t>(p); break;
+                case 4: value.integer = ReadUnaligned<uint32_t>(p); break;
+                case 8: value.integer = static_cast<long long>(ReadUnaligned<uint64_t>(p)); break;
+                default: ok = false;
+            }
+        }
+        else ok = false;
+        if (ok && value.kind == Kind::Integer) value.real = static_cast<double>(value.integer);
+    }
+    PyBuffer_Release(&view);
+    return ok;
+}
+
+// Objects FromPyObject accepts as one number rather than as a sequence
+inline bool IsPyNumber(PyObject* obj) {
+    if (PyFloat_Check(obj) || PyLong_Check(obj) || PyComplex_Check(obj)) return true;
+    BufferScalar scalar;
+    return ReadBufferScalar(obj, scalar);
+}
+
 // ---------- FromPyObject ----------
 template<typename T>
 T FromPyObject(PyObject* obj);
@@ -14,6 +118,8 @@ template<>
 inline double FromPyObject<double>(PyObject* obj) {
     if (PyFloat_Check(obj)) return PyFloat_AsDouble(obj);
     if (PyLong_Check(obj))  return static_cast<double>(PyLong_AsLong(obj));
+    BufferScalar scalar;
+    if (ReadBufferScalar(obj, scalar) && scalar.kind != BufferScalar::Kind::Complex) return scalar.real;
     throw std::runtime_error("FromPyObject<double>: object is not a number");
 }
 
@@ -24,9 +130,92 @@ inline std::complex<double> FromPyObject<std::complex<double>>(PyObject* obj) {
         return { PyComplex_RealAsDouble(obj), PyComplex_ImagAsDouble(obj) };
     if (PyFloat_Check(obj) || PyLong_Check(obj))
         return { PyFloat_AsDouble(obj), 0.0 };
+    BufferScalar scalar;
+    if (ReadBufferScalar(obj, scalar)) return { scalar.real, scalar.imag };
     throw std::runtime_error("FromPyObject<complex<double>>: invalid object");
 }
 
+// specialization for float
+template<>
+inline float FromPyObject<float>(PyObject* obj) {
+    return static_cast<float>(FromPyObject<double>(obj));
+}
+
+// specialization for int64_t, floats are accepted when they hold an integral value
+template<>
+inline int64_t FromPyObject<int64_t>(PyObject* obj) {
+    if (PyLong_Check(obj)) {
+        long long value = PyLong_AsLongLong(obj);
+        if (value == -1 && PyErr_Occurred()) {
+            PyErr_Clear();
+            throw std::runtime_error("FromPyObject<int64_t>: integer out of range");
+        }
+        return static_cast<int64_t>(value);
+    }
+    double real;
+    BufferScalar scalar;
+    if (PyFloat_Check(obj)) {
+        real = PyFloat_AsDouble(obj);
+    } else if (ReadBufferScalar(obj, scalar) && scalar.kind != BufferScalar::Kind::Complex) {
+        if (scalar.kind == BufferScalar::Kind::Integer) return static_cast<int64_t>(scalar.integer);
+        real = scalar.real;
+    } else {
+        throw std::runtime_error("FromPyObject<int64_t>: object is not a number");
+    }
+    if (real != std::trunc(real)) throw std::runtime_error("FromPyObject<int64_t>: number is not integral");
+    return static_cast<int64_t>(real);
+}
+
+// specialization for bool, numbers are true when nonzero
+template<>
+inline bool FromPyObject<bool>(PyObject* obj) {
+    if (obj == Py_True) return true;
+    if (obj == Py_False) return false;
+    if (PyLong_Check(obj) || PyFloat_Check(obj)) return PyObject_IsTrue(obj) == 1;
+    BufferScalar scalar;
+    if (ReadBufferScalar(obj, scalar)) return scalar.real != 0.0 || scalar.imag != 0.0;
+    throw std::runtime_error("FromPyObject<bool>: object is not a bool or number");
+}
+
+// Appends the elements of a (possibly nested) sequence in row-major order
+template<typename E>
+void FlattenPySequence(PyObject* obj, std::vector<E>& out) {
+    if (IsPyNumber(obj)) {
+        out.push_back(FromPyObject<E>(obj));
+        return;
+    }
+    PyObject* seq = PySequence_Fast(obj, "expected a number or a sequence of numbers");
+    if (!seq) {
+        PyErr_Clear();
+        throw std::runtime_error("FromPyObject<vector>: object is not a sequence of numbers");
+    }
+    for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(seq); ++i) {
+        try {
+            FlattenPySequence<E>(PySequence_Fast_GET_ITEM(seq, i), out);
+        } catch (...) {
+            Py_DECREF(seq);
+            throw;
+        }
+    }
+    Py_DECREF(seq);
+}
+
+// specialization for vector<double>, nested sequences are flattened row-major
+template<>
+inline std::vector<double> FromPyObject<std::vector<double>>(PyObject* obj) {
+    std::vector<double> out;
+    FlattenPySequence<double>(obj, out);
+    return out;
+}
+
+// specialization for vector<complex<double>>, nested sequences are flattened row-major
+template<>
+inline std::vector<std::complex<double>> FromPyObject<std::vector<std::complex<double>>>(PyObject* obj) {
+    std::vector<std::complex<double>> out;
+    FlattenPySequence<std::complex<double>>(obj, out);
+    return out;
+}
+
 
 // ---------- ToPyObject ----------
 template<typename T>
@@ -44,4 +233,174 @@ inline PyObject* ToPyObject<std::complex<double>>(const std::complex<double>& v)
     return PyComplex_FromDoubles(v.real(), v.imag());
 }
 
+// specialization for float
+template<>
+inline PyObject* ToPyObject<float>(const float& v) {
+    return PyFloat_FromDouble(v);
+}
+
+// specialization for int64_t
+template<>
+inline PyObject* ToPyObject<int64_t>(const int64_t& v) {
+    return PyLong_FromLongLong(v);
+}
+
+// specialization for bool
+template<>
+inline PyObject* ToPyObject<bool>(const bool& v) {
+    return PyBool_FromLong(v);
+}
+
+// ---------- RefillPyObject ----------
+// Overwrites the value of a float or complex object nobody else references, so the bridge can
+// hand python the same object again instead of a new one. Returns false (obj untouched) when
+// obj is shared, of another type, or T boxes into objects CPython may share (ints, bools).
+template<typename T>
+inline bool RefillPyObject(PyObject* obj, const T& v) {
+    if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+        if (!PyFloat_CheckExact(obj) || Py_REFCNT(obj) != 1) return false;
+        reinterpret_cast<PyFloatObject*>(obj)->ob_fval = static_cast<double>(v);
+        return true;
+    } else if constexpr (std::is_same_v<T, std::complex<double>>) {
+        if (!PyComplex_CheckExact(obj) || Py_REFCNT(obj) != 1) return false;
+        reinterpret_cast<PyComplexObject*>(obj)->cval = Py_complex{v.real(), v.imag()};
+        return true;
+    } else {
+        return false;
+    }
+}
+
+template<typename E>
+PyObject* ToPyList(const std::vector<E>& v) {
+    PyObject* list = PyList_New(static_cast<Py_ssize_t>(v.size()));
+    for (size_t i = 0; i < v.size(); ++i) {
+        PyList_SET_ITEM(list, static_cast<Py_ssize_t>(i), ToPyObject<E>(v[i]));
+    }
+    return list;
+}
+
+// specialization for vector<double>, as a flat list (copy)
+template<>
+inline PyObject* ToPyObject<std::vector<double>>(const std::vector<double>& v) {
+    return ToPyList(v);
+}
+
+// specialization for vector<complex<double>>, as a flat list (copy)
+template<>
+inline PyObject* ToPyObject<std::vector<std::complex<double>>>(const std::vector<std::complex<double>>& v) {
+    return ToPyList(v);
+}
+
+
+// ---------- Buffer views ----------
+template<typename T>
+const char* BufferFormat();
+
+template<>
+inline const char* BufferFormat<double>() {
+    return "d";
+}
+
+template<>
+inline const char* BufferFormat<std::complex<double>>() {
+    return "Zd";
+}
+
+template<>
+inline const char* BufferFormat<float>() {
+    return "f";
+}
+
+template<>
+inline const char* BufferFormat<int64_t>() {
+    return "q";
+}
+
+template<>
+inline const char* BufferFormat<bool>() {
+    return "?";
+}
+
+// True if a buffer format describes the same element as BufferFormat<T>(), e.g. numpy exports int64 as "l"
+template<typename T>
+bool BufferFormatMatches(const char* format) {
+    if (std::strcmp(format, BufferFormat<T>()) == 0) return true;
+    if constexpr (std::is_same_v<T, int64_t>) {
+        return sizeof(long) == sizeof(int64_t) && std::strcmp(format, "l") == 0;
+    }
+    return false;
+}
+
+// Exposes contiguous row-major storage as a memoryview with the struct format of T.
+// No copy is made: the storage must stay valid and in place while the view is alive.
+template<typename T>
+PyObject* ToPyMemoryView(T* data, const std::vector<Py_ssize_t>& shape, bool readonly) {
+    static T emptyStorage{};
+    std::vector<Py_ssize_t> strides(shape.size());
+    Py_ssize_t len = static_cast<Py_ssize_t>(sizeof(T));
+    for (size_t d = shape.size(); d-- > 0;) {
+        strides[d] = len;
+        len *= shape[d];
+    }
+    Py_buffer view{};
+    view.buf = data ? static_cast<void*>(data) : static_cast<void*>(&emptyStorage);
+    view.obj = nullptr;
+    view.len = len;
+    view.itemsize = sizeof(T);
+    view.readonly = readonly ? 1 : 0;
+    view.ndim = static_cast<int>(shape.size());
+    view.format = const_cast<char*>(BufferFormat<T>());
+    view.shape = const_cast<Py_ssize_t*>(shape.data());
+    view.strides = strides.data();
+    // the memoryview keeps its own copy of shape and strides
+    return PyMemoryView_FromBuffer(&view);
+}
+
+// 2-D variant of the above
+template<typename T>
+PyObject* ToPyMemoryView(T* data, Py_ssize_t rows, Py_ssize_t cols, bool readonly) {
+    return ToPyMemoryView<T>(data, std::vector<Py_ssize_t>{ rows, cols }, readonly);
+}
+
+// 1-D variant of the above
+template<typename T>
+PyObject* ToPyMemoryView(T* data, Py_ssize_t count, bool readonly) {
+    static T emptyStorage{};
+    Py_buffer view{};
+    view.buf = data ? static_cast<void*>(data) : static_cast<void*>(&emptyStorage);
+    view.obj = nullptr;
+    view.len = count * static_cast<Py_ssize_t>(sizeof(T));
+    view.itemsize = sizeof(T);
+    view.readonly = readonly ? 1 : 0;
+    view.ndim = 1;
+    view.format = const_cast<char*>(BufferFormat<T>());
+    view.shape = &count;
+    view.strides = &view.itemsize;
+    return PyMemoryView_FromBuffer(&view);
+}
+
+// Copies count elements out of obj if it exports a C-contiguous buffer of exactly that many T.
+// Returns false (with no python error set) if obj cannot be read that way.
+template<typename T>
+bool CopyFromPyBuffer(PyObject* obj, T* dest, size_t count) {
+    if (!PyObject_CheckBuffer(obj)) return false;
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(obj, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+        PyErr_Clear();
+        return false;
+    }
+
+    const char* format = view.format ? view.format : "B";
+    if (*format == '@' || *format == '=') ++format;
+    bool matches = BufferFormatMatches<T>(format)
+                   && view.itemsize == static_cast<Py_ssize_t>(sizeof(T))
+                   && view.len == static_cast<Py_ssize_t>(count * sizeof(T));
+    if (matches) {
+        std::memcpy(dest, view.buf, count * sizeof(T));
+    }
+    PyBuffer_Release(&view);
+    return matches;
+}
+
 } // namespace
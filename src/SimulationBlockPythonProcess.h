@@ -0,0 +1,183 @@
+#ifndef SRC_PYTHON_SIMULATION_BLOCK_PROCESS_H
+#define SRC_PYTHON_SIMULATION_BLOCK_PROCESS_H
+
+#pragma once
+
+#include <complex>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <PySysLinkBase/ISimulationBlock.h>
+#include <PySysLinkBase/IBlockEventsHandler.h>
+#include <PySysLinkBase/PortsAndSignalValues/InputPort.h>
+#include <PySysLinkBase/PortsAndSignalValues/OutputPort.h>
+#include <PySysLinkBase/SampleTime.h>
+#include <PySysLinkBase/ConfigurationValue.h>
+#include <spdlog/spdlog.h>
+
+#include "ConfigurationMapping.h"
+#include "ProcessWorkerPool.h"
+#include "TypedSignalHandle.h"
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+/*
+ * Same block interface as SimulationBlockPython, but the Python instance lives in a
+ * worker process (ExecutionBackend: "Process"). Inputs and outputs cross the process
+ * boundary as raw double/complex128 values through the worker's shared memory rings.
+ *
+ * The Python class uses the list API: compute(self, inputs: list, t: float) -> list.
+ * Configuration updates reach its optional update_configuration(key, value) as in SimulationBlockPython.
+ */
+template <typename T>
+class SimulationBlockPythonProcess : public PySysLinkBase::ISimulationBlock
+{
+
+public:
+    SimulationBlockPythonProcess(std::map<std::string, PySysLinkBase::ConfigurationValue> blockConfiguration,
+                                 std::shared_ptr<PySysLinkBase::IBlockEventsHandler> eventsHandler,
+                                 std::shared_ptr<ProcessWorker> worker)
+        : ISimulationBlock(blockConfiguration, eventsHandler), worker(worker)
+    {
+        std::vector<PySysLinkBase::SampleTimeType> supportedSampleTimeTypes = {};
+        supportedSampleTimeTypes.push_back(PySysLinkBase::SampleTimeType::continuous);
+        supportedSampleTimeTypes.push_back(PySysLinkBase::SampleTimeType::discrete);
+        this->sampleTime = std::make_shared<PySysLinkBase::SampleTime>(PySysLinkBase::SampleTimeType::inherited, supportedSampleTimeTypes);
+
+        // optional: number of ports
+        try {
+            numInputs = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<int>("InputPortNumber", blockConfiguration);
+        } catch(std::out_of_range&) {
+            numInputs = 1;
+        }
+        try {
+            numOutputs = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<int>("OutputPortNumber", blockConfiguration);
+        } catch(std::out_of_range&) {
+            numOutputs = 1;
+        }
+        // the worker reads the port counts from the forwarded configuration
+        blockConfiguration["InputPortNumber"] = numInputs;
+        blockConfiguration["OutputPortNumber"] = numOutputs;
+
+        // create ports
+        for (int i = 0; i < numInputs; ++i)
+        {
+            std::shared_ptr<PySysLinkBase::UnknownTypeSignalValue> signalValue = std::make_shared<PySysLinkBase::SignalValue<T>>(PySysLinkBase::SignalValue<T>(0.0));
+            auto inputPort = std::make_shared<PySysLinkBase::InputPort>(PySysLinkBase::InputPort(false, signalValue));
+            inputPorts.push_back(inputPort);
+        }
+        for (int i = 0; i < numOutputs; ++i)
+        {
+            outputValues.push_back(std::make_shared<PySysLinkBase::SignalValue<T>>(PySysLinkBase::SignalValue<T>(0.0)));
+            auto outputPort = std::make_shared<PySysLinkBase::OutputPort>(PySysLinkBase::OutputPort(outputValues.back()));
+            this->outputPorts.push_back(outputPort);
+        }
+
+        inputSignals.resize(numInputs);
+        for (int i = 0; i < numInputs; ++i) inputSignals[i].Resolve(inputPorts[i]->GetValue());
+
+        inputBuffer.assign(numInputs, T(0.0));
+        response.reserve(numOutputs * sizeof(T));
+
+        // instantiate the python class on the worker
+        blockId = worker->NextBlockId();
+        std::string configurationJson = ConfigurationToJson(blockConfiguration);
+        worker->Call(WorkerMessageType::Create, blockId, 0.0, configurationJson.data(), configurationJson.size(), response);
+    }
+
+    ~SimulationBlockPythonProcess()
+    {
+        try {
+            worker->Call(WorkerMessageType::Destroy, blockId, 0.0, nullptr, 0, response);
+        } catch (std::exception& e) {
+            spdlog::warn("SimulationBlockPythonProcess: could not destroy remote block: {}", e.what());
+        }
+    }
+
+    // ISimulationBlock required overrides
+    const std::shared_ptr<PySysLinkBase::SampleTime> GetSampleTime() const override
+    {
+        return this->sampleTime;
+    }
+
+    void SetSampleTime(std::shared_ptr<PySysLinkBase::SampleTime> st) override
+    {
+        this->sampleTime = st;
+    }
+
+    std::vector<std::shared_ptr<PySysLinkBase::InputPort>> GetInputPorts() const override
+    {
+        return this->inputPorts;
+    }
+
+    const std::vector<std::shared_ptr<PySysLinkBase::OutputPort>> GetOutputPorts() const override
+    {
+        return this->outputPorts;
+    }
+
+    // Sends the inputs to the worker, which runs compute(inputs, currentTime) and replies with the outputs
+    const std::vector<std::shared_ptr<PySysLinkBase::OutputPort>> _ComputeOutputsOfBlock(
+        const std::shared_ptr<PySysLinkBase::SampleTime> sampleTime, double currentTime, bool isMinorStep = false) override
+    {
+        for (size_t i = 0; i < inputPorts.size(); ++i)
+        {
+            inputBuffer[i] = inputSignals[i].Resolve(inputPorts[i]->GetValue())->GetPayload();
+        }
+
+        worker->Call(WorkerMessageType::Compute, blockId, currentTime, inputBuffer.data(), inputBuffer.size() * sizeof(T), response);
+        if (response.size() < outputPorts.size() * sizeof(T))
+        {
+            throw std::runtime_error("SimulationBlockPythonProcess: worker returned fewer outputs than NumOutputs");
+        }
+
+        for (size_t i = 0; i < outputPorts.size(); ++i)
+        {
+            T val;
+            std::memcpy(&val, response.data() + i * sizeof(T), sizeof(T));
+            outputValues[i]->SetPayload(val);
+            outputPorts[i]->SetValue(outputValues[i]);
+        }
+        return outputPorts;
+    }
+
+    // Forwards the update to update_configuration(key, value) of the remote instance
+    bool _TryUpdateConfigurationValue(std::string keyName, PySysLinkBase::ConfigurationValue value) override
+    {
+        if (IsBridgeConfigurationKey(keyName))
+        {
+            return false;
+        }
+
+        std::string updateJson = ConfigurationToJson({{keyName, value}});
+        try {
+            worker->Call(WorkerMessageType::UpdateConfiguration, blockId, 0.0, updateJson.data(), updateJson.size(), response);
+        } catch (std::runtime_error& e) {
+            spdlog::warn("SimulationBlockPythonProcess: update_configuration({}) failed: {}", keyName, e.what());
+            return false;
+        }
+        return !response.empty() && response[0] != 0;
+    }
+
+private:
+    int numInputs = 1;
+    int numOutputs = 1;
+
+    std::shared_ptr<PySysLinkBase::SampleTime> sampleTime;
+    std::vector<std::shared_ptr<PySysLinkBase::InputPort>> inputPorts;
+    std::vector<std::shared_ptr<PySysLinkBase::OutputPort>> outputPorts;
+    std::vector<TypedSignalHandle<T>> inputSignals;
+    std::vector<std::shared_ptr<PySysLinkBase::SignalValue<T>>> outputValues;
+
+    std::shared_ptr<ProcessWorker> worker;
+    uint32_t blockId = 0;
+    std::vector<T> inputBuffer;
+    std::vector<char> response;
+};
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_PYTHON_SIMULATION_BLOCK_PROCESS_H
@@ -0,0 +1,193 @@
+#include "SubInterpreterPool.h"
+
+#include <functional>
+#include <stdexcept>
+
+#include <PySysLinkBase/ConfigurationValue.h>
+#include <spdlog/spdlog.h>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+SubInterpreterWorker::SubInterpreterWorker(const std::vector<std::string>& modulePaths)
+{
+#if PY_VERSION_HEX >= 0x030C0000
+    PyThreadState* mainThreadState = PyThreadState_Get();
+
+    PyInterpreterConfig config = {};
+    config.use_main_obmalloc = 0;
+    config.allow_fork = 0;
+    config.allow_exec = 0;
+    config.allow_threads = 1;
+    config.allow_daemon_threads = 0;
+    config.check_multi_interp_extensions = 1;
+    config.gil = PyInterpreterConfig_OWN_GIL;
+
+    // releases the main GIL and leaves the new interpreter's GIL held
+    creationThreadState = nullptr;
+    PyStatus status = Py_NewInterpreterFromConfig(&creationThreadState, &config);
+    if (PyStatus_Exception(status))
+    {
+        PyEval_RestoreThread(mainThreadState);
+        throw std::runtime_error("SubInterpreterWorker: Could not create sub-interpreter");
+    }
+
+    PyObject* sysPath = PySys_GetObject("path"); // borrowed reference
+    for (const auto& pathStr : modulePaths)
+    {
+        PyObject* path = PyUnicode_FromString(pathStr.c_str());
+        if (PyList_Append(sysPath, path) != 0)
+        {
+            spdlog::warn("Failed to append {} to sub-interpreter sys.path", pathStr);
+            PyErr_Clear();
+        }
+        Py_DECREF(path);
+    }
+
+    interpreter = PyThreadState_GetInterpreter(creationThreadState);
+
+    // the worker thread creates its own thread state and then drops this one
+    PyEval_SaveThread();
+    PyEval_RestoreThread(mainThreadState);
+
+    thread = std::thread(&SubInterpreterWorker::WorkerLoop, this);
+#else
+    (void)modulePaths;
+    throw std::runtime_error("SubInterpreterWorker: sub-interpreters with their own GIL require Python 3.12");
+#endif
+}
+
+SubInterpreterWorker::~SubInterpreterWorker()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskReady.notify_one();
+    if (thread.joinable())
+    {
+        thread.join();
+    }
+}
+
+void SubInterpreterWorker::Run(void (*fn)(void*), void* context)
+{
+    // nested calls from the worker itself, GIL already held
+    if (std::this_thread::get_id() == thread.get_id())
+    {
+        fn(context);
+        return;
+    }
+
+    std::lock_guard<std::mutex> callLock(callMutex);
+    std::unique_lock<std::mutex> lock(mutex);
+    pendingFn = fn;
+    pendingContext = context;
+    pendingException = nullptr;
+    hasTask = true;
+    taskReady.notify_one();
+    taskDone.wait(lock, [this] { return !hasTask; });
+
+    if (pendingException)
+    {
+        std::exception_ptr exception = pendingException;
+        pendingException = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void SubInterpreterWorker::WorkerLoop()
+{
+#if PY_VERSION_HEX >= 0x030C0000
+    PyThreadState* threadState = PyThreadState_New(interpreter);
+    PyEval_RestoreThread(threadState);
+    PyThreadState_Clear(creationThreadState);
+    PyThreadState_Delete(creationThreadState);
+    creationThreadState = nullptr;
+    PyEval_SaveThread();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        taskReady.wait(lock, [this] { return hasTask || stopping; });
+        if (!hasTask)
+        {
+            break;
+        }
+
+        lock.unlock();
+        PyEval_RestoreThread(threadState);
+        try
+        {
+            pendingFn(pendingContext);
+        }
+        catch (...)
+        {
+            pendingException = std::current_exception();
+        }
+        PyEval_SaveThread();
+        lock.lock();
+
+        hasTask = false;
+        taskDone.notify_all();
+    }
+    lock.unlock();
+
+    PyEval_RestoreThread(threadState);
+    Py_EndInterpreter(threadState);
+#endif
+}
+
+SubInterpreterPool::SubInterpreterPool(int count, const std::string& mapping, const std::vector<std::string>& modulePaths)
+    : mapping(mapping)
+{
+    if (mapping != "RoundRobin" && mapping != "ByModule")
+    {
+        throw std::invalid_argument("SubInterpreterPool: Unsupported subInterpreterMapping: " + mapping);
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        workers.push_back(std::make_shared<SubInterpreterWorker>(modulePaths));
+    }
+    spdlog::info("Started {} Python sub-interpreters, mapping {}", count, mapping);
+}
+
+std::shared_ptr<IPythonExecutor> SubInterpreterPool::ExecutorForBlock(const std::map<std::string, PySysLinkBase::ConfigurationValue>& blockConfiguration)
+{
+    try {
+        int index = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<int>("InterpreterIndex", blockConfiguration);
+        if (index < 0)
+        {
+            return MainInterpreterExecutor::Instance();
+        }
+        if (index >= (int)workers.size())
+        {
+            throw std::invalid_argument("SubInterpreterPool: InterpreterIndex out of range: " + std::to_string(index));
+        }
+        return workers[index];
+    } catch (std::out_of_range&) {
+        // no explicit index, use the mapping policy
+    }
+
+    if (mapping == "ByModule")
+    {
+        std::string moduleName = PySysLinkBase::ConfigurationValueManager::TryGetConfigurationValue<std::string>("PythonModule", blockConfiguration);
+        return workers[std::hash<std::string>{}(moduleName) % workers.size()];
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return workers[nextWorker++ % workers.size()];
+}
+
+std::vector<std::shared_ptr<IPythonExecutor>> SubInterpreterPool::GetExecutors() const
+{
+    return std::vector<std::shared_ptr<IPythonExecutor>>(workers.begin(), workers.end());
+}
+
+bool SubInterpreterPool::IsSupported()
+{
+    return PY_VERSION_HEX >= 0x030C0000;
+}
+
+} // namespace BlockTypeSupports::BasicPythonSupport
@@ -0,0 +1,90 @@
+#ifndef SRC_SUB_INTERPRETER_POOL_H
+#define SRC_SUB_INTERPRETER_POOL_H
+
+#pragma once
+
+#include <Python.h>
+
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <PySysLinkBase/ConfigurationValue.h>
+
+#include "PythonExecutor.h"
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+/*
+ * Sub-interpreter with its own GIL (PEP 684, Python >= 3.12) pinned to a worker thread.
+ *
+ * Every Run() is forwarded to the worker thread, which is the only thread that ever
+ * holds this interpreter's GIL. Blocks on different workers execute concurrently.
+ * Extension modules that do not support multiple interpreters (e.g. numpy) fail to
+ * import inside a worker.
+ */
+class SubInterpreterWorker : public IPythonExecutor
+{
+public:
+    // Caller must hold the main interpreter GIL; it still holds it on return.
+    SubInterpreterWorker(const std::vector<std::string>& modulePaths);
+    ~SubInterpreterWorker();
+
+    void Run(void (*fn)(void*), void* context) override;
+
+private:
+    void WorkerLoop();
+
+    PyInterpreterState* interpreter = nullptr;
+    PyThreadState* creationThreadState = nullptr;
+    std::thread thread;
+
+    std::mutex callMutex;  // one caller at a time
+    std::mutex mutex;      // protects the task slot
+    std::condition_variable taskReady;
+    std::condition_variable taskDone;
+    void (*pendingFn)(void*) = nullptr;
+    void* pendingContext = nullptr;
+    std::exception_ptr pendingException;
+    bool hasTask = false;
+    bool stopping = false;
+};
+
+/*
+ * Fixed set of sub-interpreter workers and the policy that maps blocks onto them.
+ *
+ * Plugin configuration:
+ *   BasicPythonSupport/subInterpreterCount:   number of workers, 0 (default) disables the pool
+ *   BasicPythonSupport/subInterpreterMapping: "RoundRobin" (default) or "ByModule"
+ * Block configuration:
+ *   InterpreterIndex: explicit worker index, -1 keeps the block on the main interpreter
+ */
+class SubInterpreterPool
+{
+public:
+    // Caller must hold the main interpreter GIL
+    SubInterpreterPool(int count, const std::string& mapping, const std::vector<std::string>& modulePaths);
+
+    std::shared_ptr<IPythonExecutor> ExecutorForBlock(const std::map<std::string, PySysLinkBase::ConfigurationValue>& blockConfiguration);
+
+    std::vector<std::shared_ptr<IPythonExecutor>> GetExecutors() const;
+
+    // True if this Python build can create sub-interpreters with their own GIL
+    static bool IsSupported();
+
+private:
+    std::vector<std::shared_ptr<SubInterpreterWorker>> workers;
+    std::string mapping;
+    size_t nextWorker = 0;
+    std::mutex mutex;
+};
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_SUB_INTERPRETER_POOL_H
@@ -0,0 +1,56 @@
+#ifndef SRC_TEXT_ESCAPING_H
+#define SRC_TEXT_ESCAPING_H
+
+#pragma once
+
+#include <cstdio>
+#include <ostream>
+#include <string>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+// Writes value as a quoted, escaped JSON string
+inline void AppendJsonString(std::ostream& out, const std::string& value)
+{
+    out << '"';
+    for (char c : value)
+    {
+        switch (c)
+        {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out << escaped;
+                }
+                else
+                {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+// Writes value as a quoted CSV field (RFC 4180), embedded quotes are doubled
+inline void AppendCsvField(std::ostream& out, const std::string& value)
+{
+    out << '"';
+    for (char c : value)
+    {
+        if (c == '"') out << '"';
+        out << c;
+    }
+    out << '"';
+}
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_TEXT_ESCAPING_H
@@ -0,0 +1,40 @@
+#ifndef SRC_TYPED_SIGNAL_HANDLE_H
+#define SRC_TYPED_SIGNAL_HANDLE_H
+
+#pragma once
+
+#include <memory>
+
+#include <PySysLinkBase/PortsAndSignalValues/SignalValue.h>
+
+namespace BlockTypeSupports::BasicPythonSupport
+{
+
+/*
+ * Typed access to the signal value a port currently holds.
+ * The dynamic cast only runs when the port hands out a different value object than last time,
+ * e.g. after the engine connects an input. A port that hands out copies pays the cast on every read.
+ */
+template <typename T>
+class TypedSignalHandle
+{
+public:
+    PySysLinkBase::SignalValue<T>* Resolve(const std::shared_ptr<PySysLinkBase::UnknownTypeSignalValue>& value)
+    {
+        if (value != held)
+        {
+            typed = value->template TryCastToTyped<T>().get();
+            held = value;
+        }
+        return typed;
+    }
+
+private:
+    // keeps typed valid, and its address from being reused by another value
+    std::shared_ptr<PySysLinkBase::UnknownTypeSignalValue> held;
+    PySysLinkBase::SignalValue<T>* typed = nullptr;
+};
+
+} // namespace BlockTypeSupports::BasicPythonSupport
+
+#endif // SRC_TYPED_SIGNAL_HANDLE_H
@@ -0,0 +1,165 @@
+"""Worker process hosting BasicPython blocks outside the simulator process.
+
+Started by ProcessWorker (ProcessWorkerPool.cpp) as
+
+    python pysyslink_python_worker.py <shm fd> <shm bytes> <ring bytes>
+                                      <request eventfd> <response eventfd>
+                                      <parent pid> <module paths json>
+
+Requests and responses travel through two byte rings in the inherited shared
+memory segment; each message is followed by a write to the matching eventfd.
+The layouts below must match ProcessWorkerPool.h.
+"""
+
+import importlib
+import json
+import mmap
+import os
+import select
+import struct
+import sys
+import traceback
+
+MESSAGE_HEADER = struct.Struct("<IIQd")
+RING_HEADER_BYTES = 32
+
+MSG_CREATE = 1
+MSG_COMPUTE = 2
+MSG_DESTROY = 3
+MSG_SHUTDOWN = 4
+MSG_UPDATE_CONFIGURATION = 5
+MSG_OK = 16
+MSG_ERROR = 17
+
+SIGNAL = (1).to_bytes(8, sys.byteorder)
+
+
+class Ring:
+    """Single producer, single consumer byte ring, see SharedMemoryRing."""
+
+    def __init__(self, buffer, offset, capacity):
+        self.buffer = buffer
+        self.offset = offset
+        self.capacity = capacity
+        self.data = offset + RING_HEADER_BYTES
+
+    def _counter(self, index):
+        return struct.unpack_from("<Q", self.buffer, self.offset + 8 * index)[0]
+
+    def available(self):
+        return self._counter(0) - self._counter(1)
+
+    def read(self, count):
+        tail = self._counter(1)
+        start = tail % self.capacity
+        first = min(count, self.capacity - start)
+        data = bytes(self.buffer[self.data + start:self.data + start + first])
+        if first < count:
+            data += bytes(self.buffer[self.data:self.data + count - first])
+        struct.pack_into("<Q", self.buffer, self.offset + 8, tail + count)
+        return data
+
+    def write(self, data):
+        head = self._counter(0)
+        if self.capacity - (head - self._counter(1)) < len(data):
+            raise RuntimeError("response of %d bytes does not fit the ring" % len(data))
+        start = head % self.capacity
+        first = min(len(data), self.capacity - start)
+        self.buffer[self.data + start:self.data + start + first] = data[:first]
+        if first < len(data):
+            self.buffer[self.data:self.data + len(data) - first] = data[first:]
+        struct.pack_into("<Q", self.buffer, self.offset, head + len(data))
+
+
+def decode_complex(obj):
+    if "__complex__" in obj:
+        real, imag = obj["__complex__"]
+        return complex(real, imag)
+    return obj
+
+
+class HostedBlock:
+    def __init__(self, config):
+        module = importlib.import_module(config["PythonModule"])
+        self.instance = getattr(module, config["PythonClass"])(config)
+        self.complex = config.get("SignalType", "Double") == "Complex"
+        self.num_inputs = config.get("InputPortNumber", 1)
+        self.num_outputs = config.get("OutputPortNumber", 1)
+        initialize = getattr(self.instance, "initialize", None)
+        if callable(initialize):
+            initialize()
+
+    def compute(self, payload, time):
+        values = memoryview(payload).cast("d").tolist()
+        if self.complex:
+            inputs = [complex(values[2 * i], values[2 * i + 1]) for i in range(self.num_inputs)]
+        else:
+            inputs = values
+        outputs = list(self.instance.compute(inputs, time))
+        if len(outputs) < self.num_outputs:
+            raise RuntimeError("compute() returned fewer outputs than NumOutputs")
+        if self.complex:
+            flat = []
+            for value in outputs[:self.num_outputs]:
+                value = complex(value)
+                flat.append(value.real)
+                flat.append(value.imag)
+            return struct.pack("<%dd" % len(flat), *flat)
+        return struct.pack("<%dd" % self.num_outputs, *(float(v) for v in outputs[:self.num_outputs]))
+
+    def update_configuration(self, key, value):
+        update = getattr(self.instance, "update_configuration", None)
+        if not callable(update):
+            return False
+        # None (no return statement) accepts, like True
+        result = update(key, value)
+        return result is None or bool(result)
+
+
+def main(argv):
+    shm_fd, shm_bytes, ring_bytes = int(argv[1]), int(argv[2]), int(argv[3])
+    request_fd, response_fd, parent_pid = int(argv[4]), int(argv[5]), int(argv[6])
+    sys.path.extend(json.loads(argv[7]))
+
+    buffer = mmap.mmap(shm_fd, shm_bytes)
+    requests = Ring(buffer, 0, ring_bytes)
+    responses = Ring(buffer, RING_HEADER_BYTES + ring_bytes, ring_bytes)
+    blocks = {}
+
+    while True:
+        ready, _, _ = select.select([request_fd], [], [], 1.0)
+        if not ready:
+            if os.getppid() != parent_pid:
+                return 0
+            continue
+        os.read(request_fd, 8)
+
+        while requests.available() >= MESSAGE_HEADER.size:
+            kind, block_id, payload_bytes, time = MESSAGE_HEADER.unpack(requests.read(MESSAGE_HEADER.size))
+            payload = requests.read(payload_bytes) if payload_bytes else b""
+
+            reply_kind, reply = MSG_OK, b""
+            try:
+                if kind == MSG_COMPUTE:
+                    reply = blocks[block_id].compute(payload, time)
+                elif kind == MSG_CREATE:
+                    blocks[block_id] = HostedBlock(json.loads(payload.decode("utf-8"), object_hook=decode_complex))
+                elif kind == MSG_UPDATE_CONFIGURATION:
+                    (key, value), = json.loads(payload.decode("utf-8"), object_hook=decode_complex).items()
+                    reply = b"\x01" if blocks[block_id].update_configuration(key, value) else b"\x00"
+                elif kind == MSG_DESTROY:
+                    blocks.pop(block_id, None)
+                elif kind != MSG_SHUTDOWN:
+                    raise RuntimeError("unknown message type %d" % kind)
+            except Exception:
+                reply_kind, reply = MSG_ERROR, traceback.format_exc().encode("utf-8")
+
+            responses.write(MESSAGE_HEADER.pack(reply_kind, block_id, len(reply), time) + reply)
+            os.write(response_fd, SIGNAL)
+
+            if kind == MSG_SHUTDOWN:
+                return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))